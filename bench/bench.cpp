@@ -0,0 +1,556 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include "../json16.h"
+#include "../json16_context.h"
+#include "../json16_indexer.h"
+#include "../json16_writer.h"
+
+#include <string>
+#include <vector>
+
+/*
+
+json16bench [-csv | -json] [-time seconds] [file...]
+
+Without files a generated corpus is used: documents shaped like the usual
+twitter.json / canada.json / citm_catalog.json plus number-, string- and
+nesting-heavy inputs, each once in a large 32 bit tape variant and once
+small enough for the 16 bit tape.
+
+phases
+	scan : structural indexer only
+	tape : Parser, indexer and tape build
+	parallel : ParserContext::ParseParallel with a thread per processor,
+		the same as tape for documents too small to split
+	traverse : visit every value through the readers
+	number : traverse and ReadNumber every number
+	string : traverse and unescape every string and name
+
+Every phase is repeated for the given time, the fastest run is reported.
+GB/s is document bytes per second, ns/value divides by the values the
+phase touches (all values, numbers, or strings and names).
+
+*/
+
+static double now()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// xorshift, so the corpus is the same on every run
+static uint64_t randomState = 88172645463325252ULL;
+
+static uint32_t nextRandom(uint32_t n)
+{
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 7;
+	randomState ^= randomState << 17;
+	return (uint32_t)(randomState % n);
+}
+
+static void appendFormat(std::string& s, const char* fmt, ...)
+{
+	char buff[256];
+	va_list args;
+	va_start(args, fmt);
+	int n = vsnprintf(buff, sizeof(buff), fmt, args);
+	va_end(args);
+	s.append(buff, n);
+}
+
+static const char* const words[] = {
+	"json", "parser", "tape", "offset", "value", "stream", "token", "buffer",
+	"index", "array", "object", "number", "string", "escape", "unicode", "vector",
+};
+
+static void appendText(std::string& s, size_t wordCount)
+{
+	for (size_t i=0; i<wordCount; ++i) {
+		if (i) {
+			s += ' ';
+		}
+		s += words[nextRandom(16)];
+	}
+}
+
+// statuses with user objects, entities and escaped non-ASCII text
+static void generateTwitter(std::string& s, size_t target)
+{
+	s = "{\"statuses\":[";
+	for (size_t i=0; s.size() < target; ++i) {
+		if (i) {
+			s += ',';
+		}
+		uint64_t id = 505874924095815681ULL + nextRandom(1000000);
+		appendFormat(s, "{\"created_at\":\"Sun Aug 31 00:%02u:%02u +0000 2014\",", nextRandom(60), nextRandom(60));
+		appendFormat(s, "\"id\":%llu,\"id_str\":\"%llu\",\"text\":\"", (unsigned long long)id, (unsigned long long)id);
+		appendText(s, 4 + nextRandom(12));
+		s += " \\u540d\\u524d:\\u524d\\u7530\\u3042\\u3086\\u307f\\n\\u3010\\u52df\\u96c6\\u3011 \\/ @aym0566x\",";
+		s += "\"source\":\"<a href=\\\"http:\\/\\/twitter.com\\/download\\/iphone\\\" rel=\\\"nofollow\\\">Twitter for iPhone<\\/a>\",";
+		s += "\"truncated\":false,\"in_reply_to_status_id\":null,";
+		appendFormat(s, "\"user\":{\"id\":%u,\"name\":\"", 1186275104 + nextRandom(100000));
+		appendText(s, 2);
+		appendFormat(s, "\",\"screen_name\":\"user%u\",\"location\":\"\\u57fc\\u7389\",\"description\":\"", nextRandom(100000));
+		appendText(s, 8 + nextRandom(8));
+		appendFormat(s, "\",\"followers_count\":%u,\"friends_count\":%u,\"verified\":%s,", nextRandom(10000), nextRandom(10000), nextRandom(2) ? "true" : "false");
+		s += "\"profile_background_color\":\"C0DEED\",\"profile_image_url\":\"http:\\/\\/pbs.twimg.com\\/profile_images\\/500\\/a.jpeg\"},";
+		appendFormat(s, "\"geo\":null,\"coordinates\":null,\"retweet_count\":%u,\"favorite_count\":%u,", nextRandom(100), nextRandom(100));
+		s += "\"entities\":{\"hashtags\":[{\"text\":\"";
+		appendText(s, 1);
+		appendFormat(s, "\",\"indices\":[%u,%u]}],\"user_mentions\":[{\"screen_name\":\"aym0566x\",\"id\":%u,\"indices\":[0,9]}]},", nextRandom(50), 50 + nextRandom(50), nextRandom(1000000));
+		s += "\"favorited\":false,\"retweeted\":false,\"lang\":\"ja\"}";
+	}
+	s += "],\"search_metadata\":{\"completed_in\":0.087,\"max_id\":505874924095815681,\"query\":\"%E4%B8%80\",\"count\":100}}";
+}
+
+// GeoJSON polygons, nearly all values are doubles with many digits
+static void generateCanada(std::string& s, size_t target)
+{
+	s = "{\"type\":\"FeatureCollection\",\"features\":[{\"type\":\"Feature\",\"properties\":{\"name\":\"Canada\"},"
+		"\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[";
+	for (size_t i=0; s.size() < target; ++i) {
+		if (i) {
+			s += ',';
+		}
+		s += '[';
+		for (size_t j=0; j<256 && s.size() < target; ++j) {
+			if (j) {
+				s += ',';
+			}
+			appendFormat(s, "[%.15f,%.15f]", -141.0 + nextRandom(8000000) * 1e-5, 41.0 + nextRandom(4300000) * 1e-5);
+		}
+		s += ']';
+	}
+	s += "]}}]}";
+}
+
+// event catalog, integer heavy with numeric string keys and nulls
+static void generateCitm(std::string& s, size_t target)
+{
+	s = "{\"areaNames\":{\"205705993\":\"Arri\\u00e8re-sc\\u00e8ne central\",\"205705994\":\"1er balcon central\"},\"events\":{";
+	size_t half = target / 2;
+	for (size_t i=0; s.size() < half; ++i) {
+		uint32_t id = 138586341 + (uint32_t)i;
+		appendFormat(s, "%s\"%u\":{\"description\":null,\"id\":%u,\"logo\":null,\"name\":\"", i ? "," : "", id, id);
+		appendText(s, 3);
+		appendFormat(s, "\",\"subTopicIds\":[%u,%u,%u],\"subjectCode\":null,\"subtitle\":null,\"topicIds\":[%u,%u]}",
+			337184269 + nextRandom(100), 337184283 + nextRandom(100), 337184263 + nextRandom(100), 324846099 + nextRandom(100), 107888604 + nextRandom(100));
+	}
+	s += "},\"performances\":[";
+	for (size_t i=0; s.size() < target; ++i) {
+		appendFormat(s, "%s{\"eventId\":%u,\"id\":%u,\"logo\":null,\"name\":null,\"prices\":[", i ? "," : "", 138586341 + nextRandom(1000), 339887544 + (uint32_t)i);
+		size_t n = 1 + nextRandom(4);
+		for (size_t j=0; j<n; ++j) {
+			appendFormat(s, "%s{\"amount\":%u,\"audienceSubCategoryId\":337100890,\"seatCategoryId\":%u}", j ? "," : "", 90250 + nextRandom(10000), 338937295 + nextRandom(10));
+		}
+		appendFormat(s, "],\"seatMapImage\":null,\"start\":%llu,\"venueCode\":\"PLEYEL_PLEYEL\"}", 1372701600000ULL + nextRandom(100000000));
+	}
+	s += "]}";
+}
+
+static void generateNumbers(std::string& s, size_t target)
+{
+	s = "[";
+	for (size_t i=0; s.size() < target; ++i) {
+		if (i) {
+			s += ',';
+		}
+		switch (nextRandom(4)) {
+		case 0: appendFormat(s, "%u", nextRandom(1000000)); break;
+		case 1: appendFormat(s, "-%u.%03u", nextRandom(100000), nextRandom(1000)); break;
+		case 2: appendFormat(s, "%.17g", nextRandom(1000000000) * 1.0e-7); break;
+		default: appendFormat(s, "%u.%ue%d", nextRandom(10), nextRandom(100000), (int)nextRandom(600) - 300); break;
+		}
+	}
+	s += "]";
+}
+
+static void generateStrings(std::string& s, size_t target)
+{
+	s = "[";
+	for (size_t i=0; s.size() < target; ++i) {
+		if (i) {
+			s += ',';
+		}
+		s += '"';
+		appendText(s, 1 + nextRandom(20));
+		if (nextRandom(4) == 0) {
+			s += " \\\"quoted\\\" \\\\ tab\\t line\\n \\u00e9\\u4e2d";
+		}
+		s += '"';
+	}
+	s += "]";
+}
+
+// objects and arrays nested 14 deep below the root, inside the parser's nesting limit
+static void generateNested(std::string& s, size_t target)
+{
+	s = "[";
+	for (size_t i=0; s.size() < target; ++i) {
+		if (i) {
+			s += ',';
+		}
+		size_t depth = 14;
+		for (size_t d=0; d<depth; ++d) {
+			s += (d & 1) ? "[" : "{\"k\":";
+		}
+		appendFormat(s, "%u", nextRandom(100));
+		for (size_t d=depth; d-- > 0;) {
+			s += (d & 1) ? "]" : "}";
+		}
+	}
+	s += "]";
+}
+
+struct Document
+{
+	std::string name;
+	std::string text;
+	bool wide;		// needs the 32 bit tape
+};
+
+// Visits every value of a container. OpT gets Name / Number / String / Other.
+template <typename OffsetT, typename OpT>
+static void walk(json16::ObjectReaderT<OffsetT> r, bool isObject, OpT& op)
+{
+	OffsetT cnt = r.GetCount();
+	for (OffsetT i=0; i<cnt; ++i) {
+		if (isObject) {
+			op.Name(r.ReadNameRef());
+		}
+		switch (r.GetValueType()) {
+		case json16::Type_object:
+			op.Other();
+			walk(r.ReadObject(), true, op);
+			break;
+		case json16::Type_array:
+			op.Other();
+			walk<OffsetT>(r.ReadArray(), false, op);
+			break;
+		case json16::Type_number:
+			op.Number(r);
+			break;
+		case json16::Type_string:
+			op.String(r);
+			break;
+		default:
+			op.Other();
+			break;
+		}
+		r.MoveNext();
+	}
+}
+
+struct CountOp
+{
+	CountOp() : values(0), numbers(0), strings(0) {}
+	void Name(const json16::StringRef&) { ++strings; }
+	template <typename ReaderT> void Number(ReaderT&) { ++values; ++numbers; }
+	template <typename ReaderT> void String(ReaderT&) { ++values; ++strings; }
+	void Other() { ++values; }
+	size_t values;
+	size_t numbers;
+	size_t strings;		// names included
+};
+
+struct TraverseOp
+{
+	TraverseOp() : sum(0) {}
+	void Name(const json16::StringRef& s) { sum += s.length; }
+	template <typename ReaderT> void Number(ReaderT&) { ++sum; }
+	template <typename ReaderT> void String(ReaderT&) { ++sum; }
+	void Other() { ++sum; }
+	size_t sum;
+};
+
+struct NumberOp
+{
+	NumberOp() : sum(0) {}
+	void Name(const json16::StringRef&) {}
+	template <typename ReaderT> void Number(ReaderT& r) { sum += r.ReadNumber(); }
+	template <typename ReaderT> void String(ReaderT&) {}
+	void Other() {}
+	double sum;
+};
+
+struct StringOp
+{
+	StringOp(char* buff) : buff(buff), sum(0) {}
+	void Name(const json16::StringRef& s) { sum += json16::Unescape(s, buff); }
+	template <typename ReaderT> void Number(ReaderT&) {}
+	template <typename ReaderT> void String(ReaderT& r) { sum += json16::Unescape(r.ReadStringRef(), buff); }
+	void Other() {}
+	char* buff;
+	size_t sum;
+};
+
+enum Phase {
+	Phase_Scan,
+	Phase_Tape,
+	Phase_Parallel,
+	Phase_Traverse,
+	Phase_Number,
+	Phase_String,
+	Phase_Count,
+};
+
+static const char* const phaseNames[] = { "scan", "tape", "parallel", "traverse", "number", "string" };
+
+struct Result
+{
+	double seconds;
+	size_t values;
+};
+
+// One run of a phase, returns something derived from the work so it is not optimized away.
+// The read phases use the tape in root, the tape phase parses into work.
+template <typename OffsetT>
+static double runPhase(Phase phase, const std::string& text, OffsetT* work, char* buff,
+	const json16::ObjectReaderT<OffsetT>& root, bool isObject)
+{
+	switch (phase) {
+	case Phase_Scan:
+		{
+			json16::StructuralIndexer indexer(text.data(), text.size());
+			uint32_t positions[json16::StructuralIndexer::BlockSize];
+			size_t n;
+			size_t total = 0;
+			while ((n = indexer.Next(positions)) != 0) {
+				total += n;
+			}
+			return (double)total;
+		}
+	case Phase_Tape:
+		{
+			json16::ParserT<OffsetT> parser(text.data(), text.size(), work);
+			return parser.ErrorMessage ? -1.0 : 1.0;
+		}
+	case Phase_Parallel:
+		{
+			// keeps its memory between runs
+			static json16::ParserContextT<OffsetT> context;
+			return context.ParseParallel(text.data(), text.size()) ? 1.0 : -1.0;
+		}
+	case Phase_Traverse:
+		{
+			TraverseOp op;
+			walk(root, isObject, op);
+			return (double)op.sum;
+		}
+	case Phase_Number:
+		{
+			NumberOp op;
+			walk(root, isObject, op);
+			return op.sum;
+		}
+	default:
+		{
+			StringOp op(buff);
+			walk(root, isObject, op);
+			return (double)op.sum;
+		}
+	}
+}
+
+static double sink;
+
+// passes the writer output on to stdout
+struct StdoutSink : json16::OutputSink
+{
+	StdoutSink() : OutputSink(buff, sizeof(buff)) {}
+	void Drain()
+	{
+		fwrite(buffer, 1, length, stdout);
+		length = 0;
+	}
+protected:
+	bool makeRoom(size_t)
+	{
+		Drain();
+		return true;
+	}
+private:
+	char buff[4096];
+};
+
+template <typename OffsetT>
+static bool benchDocument(const Document& doc, double minSeconds, Result (&results)[Phase_Count])
+{
+	// at most two tape words per source byte
+	std::vector<OffsetT> tape(doc.text.size() * 2 + 16);
+	std::vector<OffsetT> work(tape.size());
+	std::vector<char> buff(doc.text.size() + 1);
+	json16::ParserT<OffsetT> parser(doc.text.data(), doc.text.size(), &tape[0]);
+	if (parser.ErrorMessage) {
+		fprintf(stderr, "%s: %s\n", doc.name.c_str(), parser.ErrorMessage);
+		return false;
+	}
+	json16::ObjectReaderT<OffsetT> root = parser.GetObject();
+	bool isObject = (parser.GetValueType() == json16::Type_object);
+	CountOp counts;
+	walk(root, isObject, counts);
+
+	for (int p=0; p<Phase_Count; ++p) {
+		Phase phase = (Phase)p;
+		double best = 1e30;
+		double start = now();
+		size_t runs = 0;
+		do {
+			double t0 = now();
+			sink += runPhase<OffsetT>(phase, doc.text, &work[0], &buff[0], root, isObject);
+			double t = now() - t0;
+			if (t < best) {
+				best = t;
+			}
+			++runs;
+		}while (now() - start < minSeconds || runs < 3);
+		results[p].seconds = best;
+		switch (phase) {
+		case Phase_Number: results[p].values = counts.numbers; break;
+		case Phase_String: results[p].values = counts.strings; break;
+		default: results[p].values = counts.values; break;
+		}
+	}
+	return true;
+}
+
+static void usage()
+{
+	fprintf(stderr,
+		"json16bench [-csv | -json] [-time seconds] [file...]\n"
+		"  -csv           one line per document and phase (default)\n"
+		"  -json          the same records as a JSON array\n"
+		"  -time seconds  minimum time per phase, default 0.5\n"
+		"  file...        documents to use instead of the generated corpus\n"
+	);
+}
+
+static bool readFile(const char* path, std::string& text)
+{
+	FILE* f = fopen(path, "rb");
+	if (!f) {
+		return false;
+	}
+	fseek(f, 0, SEEK_END);
+	long size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	text.resize(size);
+	size_t n = size ? fread(&text[0], 1, size, f) : 0;
+	fclose(f);
+	return n == (size_t)size;
+}
+
+int main(int argc, char* argv[])
+{
+	bool json = false;
+	double minSeconds = 0.5;
+	std::vector<Document> docs;
+	for (int i=1; i<argc; ++i) {
+		if (!strcmp(argv[i], "-csv")) {
+			json = false;
+		}else if (!strcmp(argv[i], "-json")) {
+			json = true;
+		}else if (!strcmp(argv[i], "-time") && i + 1 < argc) {
+			minSeconds = atof(argv[++i]);
+		}else if (argv[i][0] == '-') {
+			usage();
+			return 1;
+		}else {
+			Document doc;
+			doc.name = argv[i];
+			if (!readFile(argv[i], doc.text)) {
+				fprintf(stderr, "cannot read %s\n", argv[i]);
+				return 1;
+			}
+			doc.wide = (doc.text.size() > 32767);
+			docs.push_back(doc);
+		}
+	}
+	if (docs.empty()) {
+		typedef void (*GenerateFunc)(std::string& s, size_t target);
+		static const struct {
+			const char* name;
+			GenerateFunc generate;
+		} generators[] = {
+			{ "twitter", generateTwitter },
+			{ "canada", generateCanada },
+			{ "citm", generateCitm },
+			{ "numbers", generateNumbers },
+			{ "strings", generateStrings },
+			{ "nested", generateNested },
+		};
+		for (size_t i=0; i<sizeof(generators)/sizeof(generators[0]); ++i) {
+			Document doc;
+			doc.name = std::string(generators[i].name) + "-large";
+			doc.wide = true;
+			generators[i].generate(doc.text, 4 << 20);
+			docs.push_back(doc);
+			doc.name = std::string(generators[i].name) + "-small";
+			doc.wide = false;
+			// the 16 bit tape holds 32KB of source
+			generators[i].generate(doc.text, 30000);
+			docs.push_back(doc);
+		}
+	}
+
+	StdoutSink out;
+	json16::Writer writer(out);
+	if (json) {
+		writer.BeginArray();
+	}else {
+		printf("document,bytes,tape,phase,values,seconds,gb_per_s,ns_per_value\n");
+	}
+	for (size_t i=0; i<docs.size(); ++i) {
+		const Document& doc = docs[i];
+		Result results[Phase_Count];
+		bool ok = doc.wide
+			? benchDocument<uint32_t>(doc, minSeconds, results)
+			: benchDocument<uint16_t>(doc, minSeconds, results);
+		if (!ok) {
+			continue;
+		}
+		for (int p=0; p<Phase_Count; ++p) {
+			const Result& r = results[p];
+			double gbps = doc.text.size() / r.seconds * 1e-9;
+			double nsPerValue = r.values ? r.seconds * 1e9 / r.values : 0.0;
+			if (json) {
+				writer.BeginObject();
+				writer.Key("document", 8);
+				writer.String(doc.name.data(), doc.name.size());
+				writer.Key("bytes", 5);
+				writer.UInt64(doc.text.size());
+				writer.Key("tape", 4);
+				writer.UInt64(doc.wide ? 32 : 16);
+				writer.Key("phase", 5);
+				writer.String(phaseNames[p], strlen(phaseNames[p]));
+				writer.Key("values", 6);
+				writer.UInt64(r.values);
+				writer.Key("seconds", 7);
+				writer.Number(r.seconds);
+				writer.Key("gb_per_s", 8);
+				writer.Number(gbps);
+				writer.Key("ns_per_value", 12);
+				writer.Number(nsPerValue);
+				writer.EndObject();
+				out.Drain();
+			}else {
+				printf("%s,%u,%d,%s,%u,%.9f,%.3f,%.2f\n",
+					doc.name.c_str(), (unsigned)doc.text.size(), doc.wide ? 32 : 16, phaseNames[p],
+					(unsigned)r.values, r.seconds, gbps, nsPerValue);
+			}
+		}
+		fflush(stdout);
+	}
+	if (json) {
+		writer.EndArray();
+		out.Drain();
+		printf("\n");
+	}
+	return sink == 0.12345 ? 1 : 0;
+}
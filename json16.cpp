@@ -1,321 +1,324 @@
-
-/*
-
-uint16_t value format
-
-string
-number
-true
-false
-null
-	isContainer : 1 (false)
-	srcPos : 15
-	
-object
-	isContainer : 1 (true)
-	isObject : 1 (true)
-	count : 14
-	string[]
-	value[]
-	
-array
-	isContainer : 1 (true)
-	isObject : 1 (false)
-	count : 14
-	value[]
-
-*/
-
 #include "json16.h"
+#include "json16_parser.h"
+#include "json16_tape.h"
+#include "json16_builder.h"
 #include "json16_scanner.h"
+#include "json16_indexer.h"
+#include "json16_number.h"
 #include "assert.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 namespace json16 {
 
-struct ValueHeader
+template <typename OffsetT>
+static inline
+double getNumber(const OffsetT* entry, const char* src)
 {
-	uint16_t position : 15;
-	uint16_t isContainer : 1;
-};
+	size_t len;
+	const char* p = getNumberText(entry, src, len);
+	return ParseDouble(p, len);
+}
 
-struct ContainerHeader
+template <typename OffsetT>
+OffsetT ObjectReaderT<OffsetT>::GetCount() const
 {
-	uint16_t count : 14;
-	uint16_t isObject : 1;
-	uint16_t isContainer : 1;
-	uint16_t size;
-};
+	return getCount(parsed[offset]);
+}
 
-static inline
-uint16_t getCount(uint16_t num)
+template <typename OffsetT>
+const OffsetT* ObjectReaderT<OffsetT>::readEntry() const
 {
-	ContainerHeader v = *(ContainerHeader*) &num;
-	assert(v.isContainer);
-	return v.count;
+	return &parsed[readOffset];
 }
 
-static inline
-Type getValueType(uint16_t num, const char* src, const uint16_t* parsed)
+template <typename OffsetT>
+void ObjectReaderT<OffsetT>::MoveNext()
 {
-	ValueHeader v = *(ValueHeader*) &num;
-	if (v.isContainer) {
-		ContainerHeader c = *(ContainerHeader*) &v;
-		return c.isObject ? Type_object : Type_array;
+	ValueHeader<OffsetT> vh = *(const ValueHeader<OffsetT>*) &parsed[readOffset];
+	if (vh.isContainer) {
+		ContainerHeader<OffsetT> ch = *(const ContainerHeader<OffsetT>*) &parsed[readOffset];
+		readOffset += ch.size;
 	}else {
-		const char* p = src + v.position;
-		switch (json16::Scan(p)) {
-		case TOKEN_TRUE: return Type_true;
-		case TOKEN_FALSE: return Type_false;
-		case TOKEN_NULL: return Type_null;
-		case TOKEN_STRING: return Type_string;
-		case TOKEN_NUMBER: return Type_number;
-		}
+		readOffset += 2;
 	}
-	return Type_array;
-}
-
-static inline
-const char* getString(uint16_t num, const char* src)
-{
-	ValueHeader v = *(ValueHeader*) &num;
-	assert(!v.isContainer);
-	const char* op = src + v.position;
-	const char* p = op;
-	TokenType tt = json16::Scan(p);
-	assert(tt == TOKEN_STRING);
-	return op;
 }
 
-static inline
-double getNumber(uint16_t num, const char* src)
+template <typename OffsetT>
+const char* ObjectReaderT<OffsetT>::ReadName()
 {
-	ValueHeader v = *(ValueHeader*) &num;
-	assert(!v.isContainer);
-	const char* op = src + v.position;
-	const char* p = op;
-	TokenType tt = json16::Scan(p);
-	assert(tt == TOKEN_NUMBER);
-	char buff[64];
-	memcpy(buff, op, p-op);
-	buff[p-op] = 0;
-	char* endptr;
-	return strtod(buff, &endptr);
+	const char* name = getString(&parsed[readOffset], src);
+	readOffset += 2;
+	return name;
 }
 
-uint16_t ObjectReader::GetCount() const
+template <typename OffsetT>
+StringRef ObjectReaderT<OffsetT>::ReadNameRef()
 {
-	return getCount(parsed[offset]);
+	StringRef name = getStringRef(&parsed[readOffset], src);
+	readOffset += 2;
+	return name;
 }
 
-uint16_t ObjectReader::readValue() const
+template <typename OffsetT>
+Type ObjectReaderT<OffsetT>::GetValueType() const
 {
-	return parsed[readOffset];
+	return getValueType(readEntry());
 }
 
-void ObjectReader::MoveNext()
+template <typename OffsetT>
+const char* ObjectReaderT<OffsetT>::ReadString()
 {
-	ValueHeader vh = *(const ValueHeader*) &parsed[readOffset];
-	if (vh.isContainer) {
-		ContainerHeader ch = *(const ContainerHeader*) &parsed[readOffset];
-		readOffset += ch.size;
-	}else {
-		++readOffset;
-	}
+	return getString(readEntry(), src);
 }
 
-const char* ObjectReader::ReadName()
+template <typename OffsetT>
+StringRef ObjectReaderT<OffsetT>::ReadStringRef()
 {
-	return getString(parsed[readOffset++], src);
+	return getStringRef(readEntry(), src);
 }
 
-Type ObjectReader::GetValueType() const
+template <typename OffsetT>
+double ObjectReaderT<OffsetT>::ReadNumber()
 {
-	uint16_t val = readValue();
-	return getValueType(val, src, parsed);
+	return getNumber(readEntry(), src);
 }
 
-const char* ObjectReader::ReadString()
+template <typename OffsetT>
+bool ObjectReaderT<OffsetT>::ReadInt64(int64_t& value)
 {
-	uint16_t val = readValue();
-	return getString(val, src);
+	size_t len;
+	const char* p = getNumberText(readEntry(), src, len);
+	return ParseInt64(p, len, value);
 }
 
-double ObjectReader::ReadNumber()
+template <typename OffsetT>
+bool ObjectReaderT<OffsetT>::ReadUInt64(uint64_t& value)
 {
-	uint16_t val = readValue();
-	return getNumber(val, src);
+	size_t len;
+	const char* p = getNumberText(readEntry(), src, len);
+	return ParseUInt64(p, len, value);
 }
 
-ObjectReader ObjectReader::ReadObject()
+template <typename OffsetT>
+const char* ObjectReaderT<OffsetT>::ReadNumberText(size_t& length)
 {
-	uint16_t offset = readOffset;
-	return ObjectReader(offset, src, parsed);
+	return getNumberText(readEntry(), src, length);
 }
 
-ArrayReader ObjectReader::ReadArray()
+template <typename OffsetT>
+ObjectReaderT<OffsetT> ObjectReaderT<OffsetT>::ReadObject()
 {
-	uint16_t offset = readOffset;
-	return ArrayReader(offset, src, parsed);
+	OffsetT offset = readOffset;
+	return ObjectReaderT(offset, src, parsed, index);
 }
 
-Type Parser::GetValueType() const
+template <typename OffsetT>
+ArrayReaderT<OffsetT> ObjectReaderT<OffsetT>::ReadArray()
 {
-	return getValueType(*work, json, work);
+	OffsetT offset = readOffset;
+	return ArrayReaderT<OffsetT>(offset, src, parsed, index);
 }
 
-const char* Parser::GetString() const
+template <typename OffsetT>
+bool ObjectReaderT<OffsetT>::Find(const char* key, size_t len)
 {
-	return getString(*work, json);
+	const OffsetT* table = index ? findTable(index, offset) : 0;
+	if (table) {
+		size_t mask = table[0] - 1;
+		for (size_t i=hashName(key, len)&mask; ; i=(i+1)&mask) {
+			OffsetT e = table[1 + i];
+			if (!e) {
+				return false;
+			}
+			if (nameEquals(getStringRef(&parsed[e], src), key, len)) {
+				readOffset = e + 2;
+				return true;
+			}
+		}
+	}
+	OffsetT savedOffset = readOffset;
+	readOffset = offset + 2;
+	OffsetT cnt = GetCount();
+	for (OffsetT i=0; i<cnt; ++i) {
+		if (nameEquals(ReadNameRef(), key, len)) {
+			return true;
+		}
+		MoveNext();
+	}
+	readOffset = savedOffset;
+	return false;
 }
 
-double Parser::GetNumber() const
+template <typename OffsetT>
+bool ArrayReaderT<OffsetT>::At(size_t i)
 {
-	return getNumber(*work, json);
+	if (i >= this->GetCount()) {
+		return false;
+	}
+	const OffsetT* table = this->index ? findTable(this->index, this->offset) : 0;
+	if (table) {
+		this->readOffset = table[1 + i];
+		return true;
+	}
+	size_t e = this->offset + 2;
+	for (size_t n=0; n<i; ++n) {
+		e += entrySize(&this->parsed[e]);
+	}
+	this->readOffset = (OffsetT) e;
+	return true;
 }
 
-ObjectReader Parser::GetObject() const
+static inline
+size_t bucketCountFor(size_t count)
 {
-	return ObjectReader(0, json, work);
+	size_t n = 1;
+	while (n < count * 2) {
+		n <<= 1;
+	}
+	return n;
 }
 
-ArrayReader Parser::GetArray() const
+// words after the table size word, 0 when the container gets no table
+template <typename OffsetT>
+static inline
+size_t tableWordsFor(const ContainerHeader<OffsetT>& ch, const SideIndexT<OffsetT>& sideIndex)
 {
-	return ArrayReader(0, json, work);
+	if (ch.isObject) {
+		return (ch.count >= sideIndex.objectThreshold) ? bucketCountFor(ch.count) : 0;
+	}
+	// an empty array has nothing to look up
+	return (sideIndex.arrayThreshold && ch.count && ch.count >= sideIndex.arrayThreshold) ? ch.count : 0;
 }
 
-Parser::Parser(const char* json, uint16_t len, uint16_t* work)
-	:
-	json(json),
-	work(work)
+template <typename OffsetT>
+bool BuildSideIndex(const char* json, const OffsetT* tape, const SideIndexT<OffsetT>& sideIndex)
 {
-	ErrorMessage = 0;
-	uint32_t objectBits = 0;
-	uint16_t containerPositions[16];
-	uint16_t memberCounts[16];
-	size_t posIdx = 0;
-	const char* p = json;
-	uint16_t* pWork = work;
-	json16::TokenType tt = TOKEN_NULL;
-	enum Mode {
-		Mode_BeginBit = 0x10,
-		Mode_EndBit = 0x20,
-		Mode_None = 0,
-		Mode_Object_LEFT_BRACE = 1,
-		Mode_Object_NAME = 2,
-		Mode_Object_COLON = 3|Mode_BeginBit,
-		Mode_Object_VALUE = 4|Mode_EndBit,
-		Mode_Object_COMMA = 5|Mode_BeginBit,
-		Mode_Object_RIGHT_BRACE = 6|Mode_EndBit,
-		Mode_Array_LEFT_BRACKET = 7|Mode_BeginBit,
-		Mode_Array_VALUE = 8|Mode_EndBit,
-		Mode_Array_COMMA = 9|Mode_BeginBit,
-		Mode_Array_RIGHT_BRACKET = 10|Mode_EndBit,
-	} mode = Mode_None;
-	do {
-		const char* op = p;
-		tt = json16::Scan(p);
-		if (tt & TOKEN_VALUE) {
-			if (mode == Mode_Object_LEFT_BRACE || mode == Mode_Object_COMMA) {
-				if (tt == TOKEN_STRING) {
-					mode = Mode_Object_NAME;
-					*pWork++ = op - json;
-				}else {
-					ErrorMessage = "non-string value after {";
-					return;
-				}
-			}else if (mode & Mode_BeginBit) {
-				switch (mode) {
-				case Mode_Object_COLON:
-					mode = Mode_Object_VALUE;
-					break;
-				case Mode_Array_LEFT_BRACKET:
-				case Mode_Array_COMMA:
-					mode = Mode_Array_VALUE;
-					break;
+	size_t tapeSize = entrySize(tape);
+	size_t tableCount = 0;
+	size_t tableWords = 0;
+	// every entry is two words, containers are entered instead of skipped
+	for (size_t i=0; i<tapeSize; i+=2) {
+		ContainerHeader<OffsetT> ch = *(const ContainerHeader<OffsetT>*) &tape[i];
+		size_t words = ch.isContainer ? tableWordsFor(ch, sideIndex) : 0;
+		if (words) {
+			++tableCount;
+			tableWords += 1 + words;
+		}
+	}
+	size_t total = 1 + tableCount * 2 + tableWords;
+	if (total > sideIndex.capacity || total > TapeLimits<OffsetT>::MaxSize) {
+		return false;
+	}
+	OffsetT* index = sideIndex.memory;
+	index[0] = (OffsetT) tableCount;
+	OffsetT* containerOffsets = index + 1;
+	OffsetT* tableOffsets = containerOffsets + tableCount;
+	size_t tablePos = 1 + tableCount * 2;
+	size_t n = 0;
+	for (size_t i=0; i<tapeSize; i+=2) {
+		ContainerHeader<OffsetT> ch = *(const ContainerHeader<OffsetT>*) &tape[i];
+		size_t words = ch.isContainer ? tableWordsFor(ch, sideIndex) : 0;
+		if (!words) {
+			continue;
+		}
+		OffsetT* table = index + tablePos;
+		table[0] = (OffsetT) words;
+		size_t e = i + 2;
+		if (ch.isObject) {
+			// name hash buckets holding the offsets of the names
+			OffsetT* buckets = table + 1;
+			memset(buckets, 0, words * sizeof(OffsetT));
+			size_t mask = words - 1;
+			for (size_t m=0; m<ch.count; ++m) {
+				NameHash nh;
+				withUnescapedName(getStringRef(&tape[e], json), nh);
+				size_t b = nh.hash & mask;
+				while (buckets[b]) {
+					b = (b + 1) & mask;
 				}
-				ValueHeader hdr;
-				hdr.isContainer = false;
-				hdr.position = op - json;
-				*pWork++ = *(const uint16_t*)&hdr;
-				++memberCounts[posIdx];
-			}else {
-				ErrorMessage = "value in invalid position";
-				return;
+				buckets[b] = (OffsetT) e;
+				e += 2;
+				e += entrySize(&tape[e]);
 			}
 		}else {
-			switch (tt) {
-			case TOKEN_COLON:
-				if (mode != Mode_Object_NAME) {
-					ErrorMessage = ": not after object name";
-					return;
-				}
-				mode = Mode_Object_COLON;
-				break;
-			case TOKEN_COMMA:
-				if (!(mode & Mode_EndBit)) {
-					ErrorMessage = ", not after value";
-					return;
-				}
-				mode = (objectBits & 1) ? Mode_Object_COMMA : Mode_Array_COMMA;
-				break;
-			case TOKEN_LEFT_BRACE:
-				mode = Mode_Object_LEFT_BRACE;
-				objectBits = (objectBits<<1)|1;
-				containerPositions[posIdx] = pWork - work;
-				memberCounts[posIdx+1] = 0;
-				pWork += 2;
-				++posIdx;
-				break;
-			case TOKEN_RIGHT_BRACE:
-				if (!(mode & Mode_EndBit)) {
-					ErrorMessage = "} not after value";
-					return;
-				}else {
-					mode = Mode_Object_RIGHT_BRACE;
-					objectBits >>= 1;
-					--posIdx;
-					++memberCounts[posIdx];
-					uint16_t pos = containerPositions[posIdx];
-					ContainerHeader hdr;
-					hdr.isContainer = 1;
-					hdr.isObject = 1;
-					hdr.count = memberCounts[posIdx+1];
-					hdr.size = pWork - work - pos;
-					*(ContainerHeader*) &work[pos] = hdr;
-				}
-				break;
-			case TOKEN_LEFT_BRACKET:
-				mode = Mode_Array_LEFT_BRACKET;
-				objectBits <<= 1;
-				containerPositions[posIdx] = pWork - work;
-				memberCounts[posIdx+1] = 0;
-				pWork += 2;
-				++posIdx;
-				break;
-			case TOKEN_RIGHT_BRACKET:
-				if (!(mode & Mode_EndBit)) {
-					ErrorMessage = "] not after value";
-					return;
-				}else {
-					mode = Mode_Array_RIGHT_BRACKET;
-					objectBits >>= 1;
-					--posIdx;
-					++memberCounts[posIdx];
-					uint16_t pos = containerPositions[posIdx];
-					ContainerHeader hdr;
-					hdr.isContainer = 1;
-					hdr.isObject = 0;
-					hdr.count = memberCounts[posIdx+1];
-					hdr.size = pWork - work - pos;
-					*(ContainerHeader*) &work[pos] = hdr;
-				}
-				break;
+			// the offset of every element
+			OffsetT* elements = table + 1;
+			for (size_t m=0; m<ch.count; ++m) {
+				elements[m] = (OffsetT) e;
+				e += entrySize(&tape[e]);
 			}
 		}
-		int hoge = 0;
-	}while (tt != json16::TOKEN_OTHER);
+		containerOffsets[n] = (OffsetT) i;
+		tableOffsets[n] = (OffsetT) tablePos;
+		++n;
+		tablePos += 1 + words;
+	}
+	return true;
+}
+
+size_t detail::scanTokenLength(const char* token)
+{
+	const char* p = token;
+	json16::Scan(p);
+	return p - token;
+}
+
+// A valid document spends at least one byte per tape word, less one:
+// containers and names take two bytes for their two words, a scalar its own
+// byte plus the comma or colon in front of it, and only the first value of
+// an array has neither. An invalid input is cut off somewhere inside a valid
+// one, which at most lacks a value, a colon and a bracket per open container.
+size_t TapeSizeBound(size_t len, size_t maxDepth)
+{
+	return len + 3 + maxDepth;
+}
+
+// Names are four bytes or more with the colon, the value and the separator.
+// A table takes its offsets and bucket count (3 words) plus fewer than
+// 4 buckets per member; an empty object gets one bucket.
+// Elements are two bytes or more with the separator, less one per array; an
+// element table takes its 3 words plus one per element and is never empty.
+size_t SideIndexSizeBound(size_t len, size_t objectThreshold, size_t arrayThreshold)
+{
+	size_t names = len / 4;
+	size_t tables = objectThreshold ? names / objectThreshold : (len + 1) / 2;
+	size_t words = 1 + tables * 4 + names * 4;
+	if (arrayThreshold) {
+		size_t elements = len / 2 + 1;
+		words += elements / arrayThreshold * 3 + elements;
+	}
+	return words;
+}
+
+ValidationResult Validate(const char* json, size_t len)
+{
+	ValidationResult result;
+	result.ErrorMessage = 0;
+	result.ErrorOffset = 0;
+	if (len > 0xFFFFFFFFU) {
+		// the indexer reports 32 bit positions
+		result.ErrorMessage = "document too large";
+		return result;
+	}
+	StructuralIndexer indexer(json, len);
+	TapeBuilderT<uint32_t, false> checker(0);
+	result.ErrorMessage = feedTokens(json, len, indexer, checker, result.ErrorOffset);
+	return result;
 }
 
+template struct ObjectReaderT<uint16_t>;
+template struct ArrayReaderT<uint16_t>;
+template struct ParserT<uint16_t>;
+template struct ParserT<uint16_t, TrustedPolicy>;
+template bool BuildSideIndex(const char* json, const uint16_t* tape, const SideIndexT<uint16_t>& sideIndex);
+
+template struct ObjectReaderT<uint32_t>;
+template struct ArrayReaderT<uint32_t>;
+template struct ParserT<uint32_t>;
+template struct ParserT<uint32_t, TrustedPolicy>;
+template bool BuildSideIndex(const char* json, const uint32_t* tape, const SideIndexT<uint32_t>& sideIndex);
+
 } // namespace json16
+
@@ -12,65 +12,202 @@ enum Type {
 	Type_null,
 };
 
-struct ArrayReader;
+// string content between the quotes, points into the source text
+struct StringRef
+{
+	const char* ptr;
+	size_t length;
+	bool hasEscapes;	// Unescape is needed to get the actual characters
+};
+
+// Writes the unescaped content of s as UTF-8 and returns the number of bytes written.
+// dst needs room for s.length bytes, the result is never longer than that.
+size_t Unescape(const StringRef& s, char* dst);
+
+// OffsetT selects the tape word width.
+// uint16_t : documents up to 32KB, containers up to 16K members
+// uint32_t : documents up to 2GB, containers up to 1G members
+template <typename OffsetT> struct ArrayReaderT;
+
+// Caller memory for lookup tables the parser builds next to the tape.
+// Objects with at least objectThreshold members get a hash table of their names.
+// Arrays with at least arrayThreshold elements get a table of where every
+// element starts; 0 gives arrays none.
+template <typename OffsetT>
+struct SideIndexT
+{
+	SideIndexT(OffsetT* memory, size_t capacity, size_t objectThreshold = 32, size_t arrayThreshold = 0)
+		:
+		memory(memory),
+		capacity(capacity),
+		objectThreshold(objectThreshold),
+		arrayThreshold(arrayThreshold)
+	{
+	}
+	
+	OffsetT* memory;
+	size_t capacity;	// in OffsetT words
+	size_t objectThreshold;
+	size_t arrayThreshold;
+};
 
-struct ObjectReader
+template <typename OffsetT>
+struct ObjectReaderT
 {
 public:
-	ObjectReader(uint16_t offset, const char* src, const uint16_t* parsed)
+	ObjectReaderT(OffsetT offset, const char* src, const OffsetT* parsed, const OffsetT* index = 0)
 		:
 		offset(offset),
 		src(src),
 		parsed(parsed),
+		index(index),
 		readOffset(offset+2)
 	{
 	}
 	
-	uint16_t GetCount() const;
+	// cursor on an arbitrary entry of the container at offset
+	ObjectReaderT(OffsetT offset, const char* src, const OffsetT* parsed, const OffsetT* index, OffsetT readOffset)
+		:
+		offset(offset),
+		src(src),
+		parsed(parsed),
+		index(index),
+		readOffset(readOffset)
+	{
+	}
+	
+	OffsetT GetCount() const;
 	const char* ReadName();
+	StringRef ReadNameRef();
 	Type GetValueType() const;
 	const char* ReadString();
+	StringRef ReadStringRef();
 	double ReadNumber();
-	ObjectReader ReadObject();
-	ArrayReader ReadArray();
+	// false when the number has a fraction/exponent or is out of range
+	bool ReadInt64(int64_t& value);
+	bool ReadUInt64(uint64_t& value);
+	// the number token as written, for decimal types
+	const char* ReadNumberText(size_t& length);
+	ObjectReaderT ReadObject();
+	ArrayReaderT<OffsetT> ReadArray();
 	void MoveNext();
+	// Moves the cursor to the value of the member named key (unescaped).
+	// Uses the side index when the object has one, leaves the cursor alone when not found.
+	bool Find(const char* key, size_t len);
+	
+	// raw tape access for code that walks the tape itself
+	OffsetT GetTapeOffset() const { return offset; }
+	OffsetT GetReadOffset() const { return readOffset; }
+	const char* GetSource() const { return src; }
+	const OffsetT* GetTape() const { return parsed; }
+	const OffsetT* GetIndex() const { return index; }
 	
 protected:
-	uint16_t readValue() const;
-	uint16_t offset;
+	const OffsetT* readEntry() const;
+	OffsetT offset;
 	const char* src;
-	const uint16_t* parsed;
-	uint16_t readOffset;
+	const OffsetT* parsed;
+	const OffsetT* index;
+	OffsetT readOffset;
 };
 
-struct ArrayReader : ObjectReader
+template <typename OffsetT>
+struct ArrayReaderT : ObjectReaderT<OffsetT>
 {
 public:
-	ArrayReader(uint16_t offset, const char* src, const uint16_t* parsed)
+	ArrayReaderT(OffsetT offset, const char* src, const OffsetT* parsed, const OffsetT* index = 0)
 		:
-		ObjectReader(offset, src, parsed)
+		ObjectReaderT<OffsetT>(offset, src, parsed, index)
 	{
 	}
 	
+	// Moves the cursor to element i, false when there is none.
+	// Uses the side index when the array has a table, steps from the first element when not.
+	bool At(size_t i);
+	
 protected:
 	const char* ReadName();
+	StringRef ReadNameRef();
+	bool Find(const char* key, size_t len);
 };
 
-struct Parser
+enum {
+	DefaultMaxDepth = 16,
+};
+
+// Compile time choices of ParserT.
+// MaxDepth : deepest nesting accepted, the tape needs MaxDepth more words.
+// Strict : false trusts the input to be valid JSON and skips the grammar,
+//   literal, escape and UTF-8 checks. Input that is not valid after all gives
+//   a wrong tape or an error, but nothing is written past the bound.
+template <size_t MaxDepthV = DefaultMaxDepth, bool StrictV = true>
+struct ParserPolicy
+{
+	enum {
+		MaxDepth = MaxDepthV,
+		Strict = StrictV,
+	};
+};
+
+typedef ParserPolicy<DefaultMaxDepth, false> TrustedPolicy;
+
+// work needs room for TapeSizeBound(len, PolicyT::MaxDepth) words, the side
+// index for SideIndexSizeBound(len, objectThreshold, arrayThreshold) words;
+// ParserContextT in json16_context.h allocates both.
+// json16.cpp instantiates the default and the trusted policy, other policies
+// need json16_parser.h.
+template <typename OffsetT, typename PolicyT = ParserPolicy<> >
+struct ParserT
 {
 public:
-	Parser(const char* json, uint16_t len, uint16_t* work);
+	ParserT(const char* json, size_t len, OffsetT* work, const SideIndexT<OffsetT>* sideIndex = 0);
+	// a document parsed earlier, whose tape and side index are still around
+	ParserT(const char* json, const OffsetT* tape, const OffsetT* index = 0);
 	
 	Type GetValueType() const;
 	const char* GetString() const;
 	double GetNumber() const;
-	ObjectReader GetObject() const;
-	ArrayReader GetArray() const;
+	ObjectReaderT<OffsetT> GetObject() const;
+	ArrayReaderT<OffsetT> GetArray() const;
 	
 	const char* ErrorMessage;
+	size_t ErrorOffset;		// source position ErrorMessage refers to
 private:
 	const char* json;
-	uint16_t* work;
+	const OffsetT* work;
+	const OffsetT* index;
+};
+
+// Walks a finished tape in order and writes the side index for it.
+// Returns false when sideIndex.capacity is too small.
+template <typename OffsetT>
+bool BuildSideIndex(const char* json, const OffsetT* tape, const SideIndexT<OffsetT>& sideIndex);
+
+// Most tape words the parser writes for len bytes of input, valid or not.
+size_t TapeSizeBound(size_t len, size_t maxDepth = DefaultMaxDepth);
+
+// Most words a side index can take for a valid document of len bytes.
+size_t SideIndexSizeBound(size_t len, size_t objectThreshold, size_t arrayThreshold = 0);
+
+struct ValidationResult
+{
+	const char* ErrorMessage;	// 0 when the document is valid
+	size_t ErrorOffset;			// source position the error was found at
 };
 
+// Checks a document the way the parser does without writing a tape.
+// The limits of the tape offset width are not checked.
+ValidationResult Validate(const char* json, size_t len);
+
+typedef ObjectReaderT<uint16_t> ObjectReader;
+typedef ArrayReaderT<uint16_t> ArrayReader;
+typedef ParserT<uint16_t> Parser;
+typedef SideIndexT<uint16_t> SideIndex;
+
+typedef ObjectReaderT<uint32_t> ObjectReader32;
+typedef ArrayReaderT<uint32_t> ArrayReader32;
+typedef ParserT<uint32_t> Parser32;
+typedef SideIndexT<uint32_t> SideIndex32;
+
 } // namespace json16
+
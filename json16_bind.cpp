@@ -0,0 +1,456 @@
+#include "json16_bind.h"
+#include "json16_tape.h"
+#include "json16_number.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace json16 {
+
+// Hash of a name from its length and its first and last 8 bytes, cheap
+// enough to take for every member; up to 8 bytes the name is all in there.
+// Names that only differ in between get the full hash instead.
+static inline
+uint64_t bindNameKey(const char* p, size_t len, bool full)
+{
+	uint64_t first = 0;
+	uint64_t last = 0;
+	if (full) {
+		// FNV-1a
+		first = 14695981039346656037ULL;
+		for (size_t i=0; i<len; ++i) {
+			first = (first ^ (unsigned char)p[i]) * 1099511628211ULL;
+		}
+	}else if (len > 8) {
+		memcpy(&first, p, 8);
+		memcpy(&last, p + len - 8, 8);
+	}else {
+		for (size_t i=0; i<len; ++i) {
+			first |= (uint64_t)(unsigned char)p[i] << (i * 8);
+		}
+	}
+	return first ^ (last * 0x9E3779B97F4A7C15ULL) ^ ((uint64_t)len << 56);
+}
+
+BindTable::BindTable(const BindField* fields, size_t count)
+	:
+	fields(fields),
+	count(count),
+	ErrorMessage(0),
+	multiplier(0),
+	shift(64),
+	fullKey(false),
+	perfect(false)
+{
+	memset(required, 0, sizeof(required));
+	if (count > MaxFields) {
+		ErrorMessage = "too many bound fields";
+		return;
+	}
+	for (size_t i=0; i<count; ++i) {
+		if (!fields[i].optional) {
+			required[i / 64] |= (uint64_t)1 << (i % 64);
+		}
+	}
+	// at least twice as many slots as names, more when no multiplier
+	// puts every name into a slot of its own
+	unsigned bits = 1;
+	while (((size_t)1 << bits) < count * 2) {
+		++bits;
+	}
+	for (int full=0; full<2 && !perfect; ++full) {
+		fullKey = (full != 0);
+		for (size_t i=0; i<count; ++i) {
+			keys[i] = bindNameKey(fields[i].name, fields[i].nameLength, fullKey);
+		}
+		for (unsigned b=bits; b<=MaxSlotBits && !perfect; ++b) {
+			perfect = search(b);
+		}
+	}
+}
+
+bool BindTable::search(unsigned bits)
+{
+	for (uint64_t attempt=0; attempt<256; ++attempt) {
+		uint64_t m = 0x9E3779B97F4A7C15ULL + attempt * 2;
+		memset(slots, 0, sizeof(slots));
+		size_t i;
+		for (i=0; i<count; ++i) {
+			uint8_t& slot = slots[(keys[i] * m) >> (64 - bits)];
+			if (slot) {
+				break;
+			}
+			slot = (uint8_t)(i + 1);
+		}
+		if (i == count) {
+			multiplier = m;
+			shift = 64 - bits;
+			return true;
+		}
+	}
+	return false;
+}
+
+inline
+const BindField* BindTable::find(const char* name, size_t len) const
+{
+	const BindField* field;
+	if (perfect) {
+		uint64_t key = bindNameKey(name, len, fullKey);
+		size_t slot = slots[(key * multiplier) >> shift];
+		if (!slot) {
+			return 0;
+		}
+		field = &fields[slot - 1];
+		if (field->nameLength != len || keys[slot - 1] != key) {
+			return 0;
+		}
+		// a short name is all in its key
+		return ((len <= 8 && !fullKey) || memcmp(field->name, name, len) == 0) ? field : 0;
+	}
+	for (size_t i=0; i<count; ++i) {
+		field = &fields[i];
+		if (field->nameLength == len && memcmp(field->name, name, len) == 0) {
+			return field;
+		}
+	}
+	return 0;
+}
+
+struct BindNameFinder
+{
+	BindNameFinder(const BindTable& table) : table(table), field(0) {}
+	bool operator () (const char* p, size_t n)
+	{
+		field = table.find(p, n);
+		return true;
+	}
+	const BindTable& table;
+	const BindField* field;
+};
+
+const BindField* BindTable::findEscaped(const StringRef& name) const
+{
+	BindNameFinder finder(*this);
+	withUnescapedName(name, finder);
+	return finder.field;
+}
+
+const BindField* BindTable::Find(const StringRef& name) const
+{
+	if (name.hasEscapes) {
+		return findEscaped(name);
+	}
+	return find(name.ptr, name.length);
+}
+
+bool UnescapeTo(const StringRef& s, char* dst, size_t size)
+{
+	if (s.length < size) {
+		// unescaping never makes a string longer
+		dst[Unescape(s, dst)] = 0;
+		return true;
+	}
+	if (!s.hasEscapes) {
+		return false;
+	}
+	char stackBuff[256];
+	char* buff = (s.length <= sizeof(stackBuff)) ? stackBuff : (char*) malloc(s.length);
+	if (!buff) {
+		return false;
+	}
+	size_t len = Unescape(s, buff);
+	bool fits = (len < size);
+	if (fits) {
+		memcpy(dst, buff, len);
+		dst[len] = 0;
+	}
+	if (buff != stackBuff) {
+		free(buff);
+	}
+	return fits;
+}
+
+template <typename OffsetT>
+static
+const char* bindTapeObject(const char* src, const OffsetT* tape, size_t offset, const BindTable& table, char* obj);
+static
+const char* bindLazyObject(LazyReader r, const BindTable& table, char* obj, size_t depth);
+
+// The value of a member on the tape, read with the inline tape accessors
+template <typename OffsetT>
+struct TapeValue
+{
+	TapeValue(const char* src, const OffsetT* tape, size_t offset) : src(src), tape(tape), offset(offset) {}
+	Type GetType() const { return getValueType(&tape[offset]); }
+	double ReadNumber()
+	{
+		size_t len;
+		const char* p = getNumberText(&tape[offset], src, len);
+		return ParseDouble(p, len);
+	}
+	bool ReadInt64(int64_t& value)
+	{
+		size_t len;
+		const char* p = getNumberText(&tape[offset], src, len);
+		return ParseInt64(p, len, value);
+	}
+	bool ReadUInt64(uint64_t& value)
+	{
+		size_t len;
+		const char* p = getNumberText(&tape[offset], src, len);
+		return ParseUInt64(p, len, value);
+	}
+	StringRef ReadString() { return getStringRef(&tape[offset], src); }
+	const char* ReadObject(const BindTable& table, char* obj)
+	{
+		return bindTapeObject(src, tape, offset, table, obj);
+	}
+	const char* src;
+	const OffsetT* tape;
+	size_t offset;
+};
+
+// The value of the current member of a LazyReader, depth containers deep
+struct LazyValue
+{
+	LazyValue(LazyReader& r, size_t depth) : r(r), depth(depth) {}
+	Type GetType() const { return r.GetValueType(); }
+	double ReadNumber() { return r.ReadNumber(); }
+	bool ReadInt64(int64_t& value) { return r.ReadInt64(value); }
+	bool ReadUInt64(uint64_t& value) { return r.ReadUInt64(value); }
+	StringRef ReadString() { return r.ReadString(); }
+	const char* ReadObject(const BindTable& table, char* obj)
+	{
+		if (depth == DefaultMaxDepth) {
+			return "nesting too deep";
+		}
+		return bindLazyObject(r.ReadObject(), table, obj, depth + 1);
+	}
+	LazyReader& r;
+	size_t depth;
+};
+
+static const char* const wrongType = "value has the wrong type";
+static const char* const notInteger = "number is not an integer in range";
+
+// Stores the value in its field. A null value is not stored and leaves
+// isSet false.
+template <typename ValueT>
+static inline
+const char* bindValue(ValueT& v, const BindField& field, char* obj, bool& isSet)
+{
+	void* p = obj + field.offset;
+	Type type = v.GetType();
+	isSet = (type != Type_null);
+	if (!isSet) {
+		return 0;
+	}
+	switch (field.kind) {
+	case Bind_double:
+	case Bind_float:
+		if (type != Type_number) {
+			return wrongType;
+		}
+		if (field.kind == Bind_double) {
+			*(double*)p = v.ReadNumber();
+		}else {
+			*(float*)p = (float) v.ReadNumber();
+		}
+		break;
+	case Bind_int:
+	case Bind_int64:
+		{
+			int64_t n;
+			if (type != Type_number) {
+				return wrongType;
+			}
+			if (!v.ReadInt64(n)) {
+				return notInteger;
+			}
+			if (field.kind == Bind_int64) {
+				*(int64_t*)p = n;
+			}else if (n < -0x7FFFFFFFLL - 1 || n > 0x7FFFFFFFLL) {
+				return notInteger;
+			}else {
+				*(int*)p = (int) n;
+			}
+		}
+		break;
+	case Bind_unsigned:
+	case Bind_uint64:
+		{
+			uint64_t n;
+			if (type != Type_number) {
+				return wrongType;
+			}
+			if (!v.ReadUInt64(n)) {
+				return notInteger;
+			}
+			if (field.kind == Bind_uint64) {
+				*(uint64_t*)p = n;
+			}else if (n > 0xFFFFFFFFULL) {
+				return notInteger;
+			}else {
+				*(unsigned*)p = (unsigned) n;
+			}
+		}
+		break;
+	case Bind_bool:
+		if (type != Type_true && type != Type_false) {
+			return wrongType;
+		}
+		*(bool*)p = (type == Type_true);
+		break;
+	case Bind_StringRef:
+		if (type != Type_string) {
+			return wrongType;
+		}
+		*(StringRef*)p = v.ReadString();
+		break;
+	case Bind_chars:
+		if (type != Type_string) {
+			return wrongType;
+		}
+		if (!UnescapeTo(v.ReadString(), (char*)p, field.size)) {
+			return "string too long for its field";
+		}
+		break;
+	case Bind_object:
+		if (type != Type_object) {
+			return wrongType;
+		}
+		return v.ReadObject(field.nested(), (char*)p);
+	}
+	return 0;
+}
+
+// bit per field that got a value
+struct BindSeen
+{
+	BindSeen()
+	{
+		memset(bits, 0, sizeof(bits));
+	}
+	void Set(const BindTable& table, const BindField& field)
+	{
+		size_t i = &field - table.fields;
+		bits[i / 64] |= (uint64_t)1 << (i % 64);
+	}
+	bool HasRequired(const BindTable& table) const
+	{
+		for (size_t i=0; i<BindTable::MaxFields/64; ++i) {
+			if (table.required[i] & ~bits[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+	uint64_t bits[BindTable::MaxFields / 64];
+};
+
+template <typename OffsetT>
+static
+const char* bindTapeObject(const char* src, const OffsetT* tape, size_t offset, const BindTable& table, char* obj)
+{
+	if (table.ErrorMessage) {
+		return table.ErrorMessage;
+	}
+	BindSeen seen;
+	size_t count = getCount(tape[offset]);
+	size_t pos = offset + 2;
+	for (size_t i=0; i<count; ++i) {
+		const BindField* field = table.Find(getStringRef(&tape[pos], src));
+		pos += 2;
+		if (field) {
+			TapeValue<OffsetT> v(src, tape, pos);
+			bool isSet;
+			const char* err = bindValue(v, *field, obj, isSet);
+			if (err) {
+				return err;
+			}
+			if (isSet) {
+				seen.Set(table, *field);
+			}
+		}
+		pos += entrySize(&tape[pos]);
+	}
+	return seen.HasRequired(table) ? 0 : "required field missing";
+}
+
+// Walks the current value of r, depth containers deep, when it is a container
+// Bind does not read, for the checks the parser does on the whole document.
+static
+const char* checkLazyValue(LazyReader& r, size_t depth)
+{
+	Type type = r.GetValueType();
+	if (type != Type_object && type != Type_array) {
+		// Next has checked it
+		return 0;
+	}
+	if (depth == DefaultMaxDepth) {
+		return "nesting too deep";
+	}
+	LazyReader c = (type == Type_object) ? r.ReadObject() : r.ReadArray();
+	while (c.Next()) {
+		const char* err = checkLazyValue(c, depth + 1);
+		if (err) {
+			return err;
+		}
+	}
+	return c.ErrorMessage;
+}
+
+static
+const char* bindLazyObject(LazyReader r, const BindTable& table, char* obj, size_t depth)
+{
+	if (table.ErrorMessage) {
+		return table.ErrorMessage;
+	}
+	if (!r.ErrorMessage && !r.IsObject()) {
+		return wrongType;
+	}
+	BindSeen seen;
+	while (r.Next()) {
+		const BindField* field = table.Find(r.GetName());
+		if (!field || field->kind != Bind_object || r.GetValueType() != Type_object) {
+			const char* err = checkLazyValue(r, depth);
+			if (err) {
+				return err;
+			}
+		}
+		if (field) {
+			LazyValue v(r, depth);
+			bool isSet;
+			const char* err = bindValue(v, *field, obj, isSet);
+			if (err) {
+				// the reader has the better message for broken text
+				return r.ErrorMessage ? r.ErrorMessage : err;
+			}
+			if (isSet) {
+				seen.Set(table, *field);
+			}
+		}
+	}
+	if (r.ErrorMessage) {
+		return r.ErrorMessage;
+	}
+	return seen.HasRequired(table) ? 0 : "required field missing";
+}
+
+template <typename OffsetT>
+const char* BindObject(const ObjectReaderT<OffsetT>& reader, const BindTable& table, void* obj)
+{
+	return bindTapeObject(reader.GetSource(), reader.GetTape(), reader.GetTapeOffset(), table, (char*)obj);
+}
+
+const char* BindObject(const LazyReader& reader, const BindTable& table, void* obj)
+{
+	return bindLazyObject(reader, table, (char*)obj, 1);
+}
+
+template const char* BindObject(const ObjectReaderT<uint16_t>& reader, const BindTable& table, void* obj);
+template const char* BindObject(const ObjectReaderT<uint32_t>& reader, const BindTable& table, void* obj);
+
+} // namespace json16
+
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "json16.h"
+#include "json16_lazy.h"
+
+#include <stddef.h>
+
+namespace json16 {
+
+/*
+
+Decodes objects straight into plain structs. The fields are declared once,
+at global scope, with the full type name:
+
+	struct Point { double x; double y; char label[16]; };
+
+	JSON16_BIND_BEGIN(Point)
+		JSON16_BIND_FIELD(x)
+		JSON16_BIND_FIELD(y)
+		JSON16_BIND_OPTIONAL(label)
+	JSON16_BIND_END()
+
+	Point pt;
+	const char* err = json16::Bind(parser.GetObject(), pt);
+
+Field types: double, float, int, unsigned, int64_t, uint64_t, bool,
+StringRef (points into the source), char[N] (unescaped, NUL terminated) and
+any struct with its own JSON16_BIND block, which is read from a nested object.
+Members without a field are skipped, a later duplicate overwrites an earlier
+one. A field that is missing or null is left alone; that is an error unless
+the field is optional.
+
+The names are looked up through a perfect hash that is searched for once per
+struct, the first time it is bound. The fields and the hash are function
+local statics, whose construction is not thread safe in C++03 nor with MSVC
+before 2015: a program that binds from several threads has to build the
+tables before it starts them, with one call per struct, nested ones
+included:
+
+	json16::BindTraits<Point>::GetTable();
+	
+*/
+	
+enum BindKind {
+	Bind_double,
+	Bind_float,
+	Bind_int,
+	Bind_unsigned,
+	Bind_int64,
+	Bind_uint64,
+	Bind_bool,
+	Bind_StringRef,
+	Bind_chars,
+	Bind_object,
+};
+
+struct BindTable;
+typedef const BindTable& (*BindTableFunc)();
+
+struct BindField
+{
+	const char* name;
+	size_t nameLength;
+	size_t offset;			// of the member in the struct
+	BindKind kind;
+	size_t size;			// of a char array
+	BindTableFunc nested;	// fields of a nested struct
+	bool optional;
+};
+
+// The fields of a struct and a perfect hash over their names.
+struct BindTable
+{
+public:
+	enum {
+		MaxFields = 128,
+		MaxSlotBits = 9,
+	};
+	
+	BindTable(const BindField* fields, size_t count);
+	
+	// the field named name, 0 when there is none
+	const BindField* Find(const StringRef& name) const;
+	
+	const BindField* fields;
+	size_t count;
+	uint64_t required[MaxFields / 64];	// bit per field that is not optional
+	const char* ErrorMessage;			// too many fields
+private:
+	const BindField* find(const char* name, size_t len) const;
+	const BindField* findEscaped(const StringRef& name) const;
+	bool search(unsigned bits);
+	friend struct BindNameFinder;
+	
+	uint64_t multiplier;
+	unsigned shift;
+	bool fullKey;		// bindNameKey over the whole name
+	bool perfect;		// otherwise the fields are compared one by one
+	uint8_t slots[1 << MaxSlotBits];	// field index + 1, 0 for none
+	uint64_t keys[MaxFields];			// bindNameKey of every field
+};
+
+// specialized by JSON16_BIND_BEGIN
+template <typename T>
+struct BindTraits;
+
+// what a member type is read as, a bound struct when nothing else
+template <typename T>
+struct BindKindOf
+{
+	enum { Kind = Bind_object, Size = 0 };
+	static BindTableFunc Nested() { return &BindTraits<T>::GetTable; }
+};
+
+#define JSON16_BIND_KIND(type, kind) \
+	template <> \
+	struct BindKindOf<type> \
+	{ \
+		enum { Kind = kind, Size = 0 }; \
+		static BindTableFunc Nested() { return 0; } \
+	};
+
+JSON16_BIND_KIND(double, Bind_double)
+JSON16_BIND_KIND(float, Bind_float)
+JSON16_BIND_KIND(int, Bind_int)
+JSON16_BIND_KIND(unsigned, Bind_unsigned)
+JSON16_BIND_KIND(int64_t, Bind_int64)
+JSON16_BIND_KIND(uint64_t, Bind_uint64)
+JSON16_BIND_KIND(bool, Bind_bool)
+JSON16_BIND_KIND(StringRef, Bind_StringRef)
+
+#undef JSON16_BIND_KIND
+
+template <size_t N>
+struct BindKindOf<char[N]>
+{
+	enum { Kind = Bind_chars, Size = N };
+	static BindTableFunc Nested() { return 0; }
+};
+
+// the member pointer only carries the member type
+template <typename S, typename M>
+BindField MakeBindField(const char* name, size_t nameLength, size_t offset, M S::*, bool optional)
+{
+	BindField field;
+	field.name = name;
+	field.nameLength = nameLength;
+	field.offset = offset;
+	field.kind = (BindKind) BindKindOf<M>::Kind;
+	field.size = BindKindOf<M>::Size;
+	field.nested = BindKindOf<M>::Nested();
+	field.optional = optional;
+	return field;
+}
+
+#define JSON16_BIND_BEGIN(T) \
+	namespace json16 { \
+	template <> \
+	struct BindTraits<T> \
+	{ \
+		typedef T Type; \
+		static const BindTable& GetTable() \
+		{ \
+			static const BindField fields[] = {
+
+#define JSON16_BIND_NAMED(member, key, optional) \
+				MakeBindField(key, sizeof(key) - 1, offsetof(Type, member), &Type::member, optional),
+
+#define JSON16_BIND_FIELD(member) JSON16_BIND_NAMED(member, #member, false)
+#define JSON16_BIND_OPTIONAL(member) JSON16_BIND_NAMED(member, #member, true)
+
+#define JSON16_BIND_END() \
+			}; \
+			static const BindTable table(fields, sizeof(fields) / sizeof(fields[0])); \
+			return table; \
+		} \
+	}; \
+	}
+
+// Copies s unescaped into dst of size bytes with a terminating NUL.
+// Returns false when it does not fit.
+bool UnescapeTo(const StringRef& s, char* dst, size_t size);
+
+// Reads the object of reader into obj with the fields of table.
+// Returns 0 on success, the error otherwise; obj may be partly written then.
+// A LazyReader is read to the end, skipped members included, and fails on
+// what the parser with the default policy fails on.
+template <typename OffsetT>
+const char* BindObject(const ObjectReaderT<OffsetT>& reader, const BindTable& table, void* obj);
+const char* BindObject(const LazyReader& reader, const BindTable& table, void* obj);
+
+// Reads the object of an ObjectReaderT (through the tape) or a LazyReader
+// (straight from the text) into value, see BindObject.
+template <typename ReaderT, typename T>
+const char* Bind(const ReaderT& reader, T& value)
+{
+	return BindObject(reader, BindTraits<T>::GetTable(), &value);
+}
+
+template <typename OffsetT, typename PolicyT, typename T>
+const char* Bind(const ParserT<OffsetT, PolicyT>& parser, T& value)
+{
+	if (parser.ErrorMessage) {
+		return parser.ErrorMessage;
+	}
+	if (parser.GetValueType() != Type_object) {
+		return "value has the wrong type";
+	}
+	return BindObject(parser.GetObject(), BindTraits<T>::GetTable(), &value);
+}
+
+} // namespace json16
+
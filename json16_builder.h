@@ -0,0 +1,496 @@
+#pragma once
+
+// Lexing helpers and the mode machine that turns a token sequence into a tape.
+// Shared by Parser and the chunked parser (tokens from the structural indexer)
+// and StreamParser (tokens from its resumable lexer).
+
+#include "json16_tape.h"
+#include "json16_scanner.h"
+#include "json16_indexer.h"
+
+#include <string.h>
+
+namespace json16 {
+
+static inline
+bool isDelimiter(char c)
+{
+	switch (c) {
+	case ' ': case '\t': case '\n': case '\v': case '\f': case '\r':
+	case '{': case '}': case '[': case ']': case ':': case ',': case '"':
+		return true;
+	}
+	return false;
+}
+
+static inline
+bool isHexDigit(char c)
+{
+	return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+static inline
+Type tokenToType(TokenType tt)
+{
+	switch (tt) {
+	case TOKEN_TRUE: return Type_true;
+	case TOKEN_FALSE: return Type_false;
+	case TOKEN_NULL: return Type_null;
+	case TOKEN_STRING: return Type_string;
+	default: return Type_number;
+	}
+}
+
+template <typename OffsetT>
+static inline
+OffsetT* writeScalar(OffsetT* pWork, size_t position, size_t length, Type type, bool hasEscapes)
+{
+	ValueHeader<OffsetT> hdr;
+	hdr.isContainer = false;
+	hdr.position = (OffsetT)position;
+	ScalarInfo<OffsetT> si;
+	si.type = type;
+	si.hasEscapes = hasEscapes;
+	si.length = (OffsetT)((length < TapeLimits<OffsetT>::MaxLength) ? length : TapeLimits<OffsetT>::MaxLength);
+	*pWork++ = *(const OffsetT*)&hdr;
+	*pWork++ = *(const OffsetT*)&si;
+	return pWork;
+}
+
+// WriteTape = false only checks the structure, work is not touched then
+// and the limits of the tape offset width do not apply.
+// Strict = false trusts the tokens to form valid JSON and only keeps what is
+// needed to build the tape and to stay within capacity words of work.
+template <typename OffsetT, bool WriteTape = true, size_t MaxDepthV = DefaultMaxDepth, bool StrictV = true>
+struct TapeBuilderT
+{
+	enum {
+		MaxDepth = MaxDepthV,
+		Strict = StrictV,
+	};
+	
+	enum Mode {
+		Mode_BeginBit = 0x10,
+		Mode_EndBit = 0x20,
+		Mode_None = 0,
+		Mode_Object_LEFT_BRACE = 1,
+		Mode_Object_NAME = 2,
+		Mode_Object_COLON = 3|Mode_BeginBit,
+		Mode_Object_VALUE = 4|Mode_EndBit,
+		Mode_Object_COMMA = 5|Mode_BeginBit,
+		Mode_Object_RIGHT_BRACE = 6|Mode_EndBit,
+		Mode_Array_LEFT_BRACKET = 7|Mode_BeginBit,
+		Mode_Array_VALUE = 8|Mode_EndBit,
+		Mode_Array_COMMA = 9|Mode_BeginBit,
+		Mode_Array_RIGHT_BRACKET = 10|Mode_EndBit,
+	};
+	
+	// Capacity only bounds the trusted builder, see TapeSizeBound. The strict
+	// builder leaves it to the caller to keep room for two more words.
+	TapeBuilderT(OffsetT* work, size_t capacity = 0)
+		:
+		ErrorMessage(0),
+		work(work),
+		pWork(work),
+		workEnd(work + capacity),
+		posIdx(0),
+		mode(Mode_None),
+		nameNext(false)
+	{
+		memberCounts[0] = 0;
+		levelIsObject[0] = false;
+	}
+	
+	// position and length of the token in the source,
+	// hasEscapes only matters for strings
+	inline
+	bool Token(TokenType tt, size_t position, size_t length, bool hasEscapes)
+	{
+		if (!Strict) {
+			return trustedToken(tt, position, length, hasEscapes);
+		}
+		if (posIdx == 0 && mode != Mode_None) {
+			ErrorMessage = "extra content after root value";
+			return false;
+		}
+		if (tt & TOKEN_VALUE) {
+			if (mode == Mode_Object_LEFT_BRACE || mode == Mode_Object_COMMA) {
+				if (tt == TOKEN_STRING) {
+					mode = Mode_Object_NAME;
+					if (WriteTape) {
+						pWork = writeScalar(pWork, position, length, Type_string, hasEscapes);
+					}
+				}else {
+					ErrorMessage = "non-string value after {";
+					return false;
+				}
+			}else if (mode & Mode_BeginBit) {
+				switch (mode) {
+				case Mode_Object_COLON:
+					mode = Mode_Object_VALUE;
+					break;
+				case Mode_Array_LEFT_BRACKET:
+				case Mode_Array_COMMA:
+					mode = Mode_Array_VALUE;
+					break;
+				}
+				if (WriteTape) {
+					pWork = writeScalar(pWork, position, length, tokenToType(tt), tt == TOKEN_STRING && hasEscapes);
+					if (++memberCounts[posIdx] > TapeLimits<OffsetT>::MaxCount) {
+						ErrorMessage = "too many members in container for tape offset width";
+						return false;
+					}
+				}
+			}else {
+				ErrorMessage = "value in invalid position";
+				return false;
+			}
+		}else {
+			switch (tt) {
+			case TOKEN_COLON:
+				if (mode != Mode_Object_NAME) {
+					ErrorMessage = ": not after object name";
+					return false;
+				}
+				mode = Mode_Object_COLON;
+				break;
+			case TOKEN_COMMA:
+				if (!(mode & Mode_EndBit)) {
+					ErrorMessage = ", not after value";
+					return false;
+				}
+				mode = levelIsObject[posIdx] ? Mode_Object_COMMA : Mode_Array_COMMA;
+				break;
+			case TOKEN_LEFT_BRACE:
+			case TOKEN_LEFT_BRACKET:
+				if (mode == Mode_Object_LEFT_BRACE || mode == Mode_Object_COMMA) {
+					ErrorMessage = "non-string value after {";
+					return false;
+				}
+				if (mode != Mode_None && !(mode & Mode_BeginBit)) {
+					ErrorMessage = "value in invalid position";
+					return false;
+				}
+				if (posIdx == MaxDepth) {
+					ErrorMessage = "nesting too deep";
+					return false;
+				}
+				mode = (tt == TOKEN_LEFT_BRACE) ? Mode_Object_LEFT_BRACE : Mode_Array_LEFT_BRACKET;
+				openContainer(tt == TOKEN_LEFT_BRACE);
+				break;
+			case TOKEN_RIGHT_BRACE:
+			case TOKEN_RIGHT_BRACKET:
+				{
+					bool isObject = (tt == TOKEN_RIGHT_BRACE);
+					// empty containers close right after they open
+					if (!(mode & Mode_EndBit) && mode != (isObject ? Mode_Object_LEFT_BRACE : Mode_Array_LEFT_BRACKET)) {
+						if (mode == Mode_Object_LEFT_BRACE || mode == Mode_Array_LEFT_BRACKET) {
+							ErrorMessage = isObject ? "} closes an array" : "] closes an object";
+						}else {
+							ErrorMessage = isObject ? "} not after value" : "] not after value";
+						}
+						return false;
+					}
+					if (levelIsObject[posIdx] != isObject) {
+						ErrorMessage = isObject ? "} closes an array" : "] closes an object";
+						return false;
+					}
+					mode = isObject ? Mode_Object_RIGHT_BRACE : Mode_Array_RIGHT_BRACKET;
+					return closeContainer(isObject);
+				}
+			}
+		}
+		return true;
+	}
+	
+	// call once the input is exhausted
+	bool Finish()
+	{
+		if ((Strict && mode == Mode_None) || posIdx != 0) {
+			ErrorMessage = "unexpected end of input";
+			return false;
+		}
+		if (!Strict && pWork == work) {
+			ErrorMessage = "unexpected end of input";
+			return false;
+		}
+		return true;
+	}
+	
+	const char* ErrorMessage;
+	
+	OffsetT* work;
+	OffsetT* pWork;
+	OffsetT* workEnd;
+	OffsetT containerPositions[MaxDepth];
+	OffsetT memberCounts[MaxDepth + 1];	// [0] counts the root value
+	bool levelIsObject[MaxDepth + 1];	// [0] is the level around the root
+	size_t posIdx;
+	Mode mode;
+	bool nameNext;		// trusted builder: the next string is an object member name
+	
+private:
+	inline
+	void openContainer(bool isObject)
+	{
+		if (WriteTape) {
+			containerPositions[posIdx] = (OffsetT)(pWork - work);
+			memberCounts[posIdx+1] = 0;
+			pWork += 2;
+		}
+		++posIdx;
+		levelIsObject[posIdx] = isObject;
+	}
+	
+	inline
+	bool closeContainer(bool isObject)
+	{
+		--posIdx;
+		if (!WriteTape) {
+			return true;
+		}
+		if (++memberCounts[posIdx] > TapeLimits<OffsetT>::MaxCount) {
+			ErrorMessage = "too many members in container for tape offset width";
+			return false;
+		}
+		OffsetT pos = containerPositions[posIdx];
+		size_t size = pWork - work - pos;
+		if (size > TapeLimits<OffsetT>::MaxSize) {
+			ErrorMessage = "container too large for tape offset width";
+			return false;
+		}
+		ContainerHeader<OffsetT> hdr;
+		hdr.isContainer = 1;
+		hdr.isObject = isObject;
+		hdr.count = memberCounts[posIdx+1];
+		hdr.size = (OffsetT)size;
+		*(ContainerHeader<OffsetT>*) &work[pos] = hdr;
+		return true;
+	}
+	
+	// Names and values are told apart by position alone; the depth, the
+	// room left in work and the offset width limits are still checked, so
+	// input that is not valid after all gives a wrong tape or an error but
+	// writes nothing out of bounds.
+	inline
+	bool trustedToken(TokenType tt, size_t position, size_t length, bool hasEscapes)
+	{
+		if (tt & TOKEN_VALUE) {
+			if (WriteTape) {
+				if (workEnd - pWork < 2) {
+					ErrorMessage = "tape capacity exceeded";
+					return false;
+				}
+				pWork = writeScalar(pWork, position, length, tokenToType(tt), tt == TOKEN_STRING && hasEscapes);
+				if (nameNext) {
+					nameNext = false;
+				}else if (++memberCounts[posIdx] > TapeLimits<OffsetT>::MaxCount) {
+					ErrorMessage = "too many members in container for tape offset width";
+					return false;
+				}
+			}
+			return true;
+		}
+		switch (tt) {
+		case TOKEN_COMMA:
+			nameNext = levelIsObject[posIdx];
+			break;
+		case TOKEN_LEFT_BRACE:
+		case TOKEN_LEFT_BRACKET:
+			if (posIdx == MaxDepth) {
+				ErrorMessage = "nesting too deep";
+				return false;
+			}
+			if (WriteTape && workEnd - pWork < 2) {
+				ErrorMessage = "tape capacity exceeded";
+				return false;
+			}
+			nameNext = (tt == TOKEN_LEFT_BRACE);
+			openContainer(nameNext);
+			break;
+		case TOKEN_RIGHT_BRACE:
+		case TOKEN_RIGHT_BRACKET:
+			if (posIdx == 0) {
+				ErrorMessage = "unbalanced brackets";
+				return false;
+			}
+			nameNext = false;
+			return closeContainer(levelIsObject[posIdx]);
+		default:
+			break;
+		}
+		return true;
+	}
+};
+
+// lexes the number / true / false / null that starts at pos
+static inline
+TokenType scanScalar(const char* json, size_t len, size_t pos, size_t& end)
+{
+	end = pos;
+	while (end < len && !isDelimiter(json[end])) {
+		++end;
+	}
+	// the root is always a container so a scalar can never end the input
+	if (end == len) {
+		return TOKEN_OTHER;
+	}
+	const char* p = json + pos;
+	TokenType tt = json16::Scan(p);
+	if (p != json + end) {
+		return TOKEN_OTHER;
+	}
+	return tt;
+}
+
+// scanScalar for input that is known to be valid, the first byte tells the type
+static inline
+TokenType scanTrustedScalar(const char* json, size_t len, size_t pos, size_t& end)
+{
+	end = pos;
+	while (end < len && !isDelimiter(json[end])) {
+		++end;
+	}
+	if (end == len) {
+		return TOKEN_OTHER;
+	}
+	switch (json[pos]) {
+	case 't': return TOKEN_TRUE;
+	case 'f': return TOKEN_FALSE;
+	case 'n': return TOKEN_NULL;
+	default: return TOKEN_NUMBER;
+	}
+}
+
+// the indexer has already rejected control characters, only escapes are left
+static inline
+bool validateEscapes(const char* p, const char* end, bool& hasEscapes)
+{
+	hasEscapes = false;
+	while ((p = (const char*) memchr(p, '\\', end - p)) != 0) {
+		hasEscapes = true;
+		switch (p[1]) {
+		case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+			p += 2;
+			break;
+		case 'u':
+			if (end - p < 6 || !isHexDigit(p[2]) || !isHexDigit(p[3]) || !isHexDigit(p[4]) || !isHexDigit(p[5])) {
+				return false;
+			}
+			p += 6;
+			break;
+		default:
+			return false;
+		}
+	}
+	return true;
+}
+
+// validateEscapes, or only hasEscapes for a builder that trusts its input
+template <bool Strict>
+static inline
+bool checkEscapes(const char* p, const char* end, bool& hasEscapes)
+{
+	if (!Strict) {
+		hasEscapes = (memchr(p, '\\', end - p) != 0);
+		return true;
+	}
+	return validateEscapes(p, end, hasEscapes);
+}
+
+// Passes the tokens the indexer finds to builder.
+// Returns the error message, errorOffset is the source position it refers to.
+// An indexer restricted to part of json may start inside a string, whose
+// closing quote is skipped, and a string still open at the end of its range
+// is read on to the closing quote.
+// A builder that is not BuilderT::Strict gets its literals and escapes unchecked.
+template <typename BuilderT>
+static
+const char* feedTokens(const char* json, size_t len, StructuralIndexer& indexer, BuilderT& builder, size_t& errorOffset)
+{
+	uint32_t positions[StructuralIndexer::BlockSize];
+	size_t stringStart = 0;
+	bool inString = indexer.StartsInString();
+	bool skipQuote = inString;
+	bool hasEscapes = false;
+	size_t nPositions;
+	while ((nPositions = indexer.Next(positions)) != 0) {
+		for (size_t i=0; i<nPositions; ++i) {
+			size_t pos = positions[i];
+			size_t tokenStart = pos;
+			size_t tokenEnd = pos + 1;
+			json16::TokenType tt;
+			if (inString) {
+				// closing quote
+				inString = false;
+				if (skipQuote) {
+					skipQuote = false;
+					continue;
+				}
+				tokenStart = stringStart;
+				if (!checkEscapes<BuilderT::Strict>(json + tokenStart + 1, json + pos, hasEscapes)) {
+					errorOffset = tokenStart;
+					return "invalid escape sequence in string";
+				}
+				tt = TOKEN_STRING;
+			}else {
+				switch (json[pos]) {
+				case '"':
+					inString = true;
+					stringStart = pos;
+					continue;
+				case '{': tt = TOKEN_LEFT_BRACE; break;
+				case '}': tt = TOKEN_RIGHT_BRACE; break;
+				case '[': tt = TOKEN_LEFT_BRACKET; break;
+				case ']': tt = TOKEN_RIGHT_BRACKET; break;
+				case ':': tt = TOKEN_COLON; break;
+				case ',': tt = TOKEN_COMMA; break;
+				default:
+					if (BuilderT::Strict) {
+						tt = scanScalar(json, len, pos, tokenEnd);
+					}else {
+						tt = scanTrustedScalar(json, len, pos, tokenEnd);
+					}
+					if (!(tt & TOKEN_VALUE)) {
+						errorOffset = pos;
+						return "invalid token";
+					}
+					break;
+				}
+			}
+			if (!builder.Token(tt, tokenStart, tokenEnd - tokenStart, hasEscapes)) {
+				errorOffset = tokenStart;
+				return builder.ErrorMessage;
+			}
+		}
+	}
+	if (indexer.ErrorMessage) {
+		errorOffset = indexer.ErrorOffset;
+		return indexer.ErrorMessage;
+	}
+	if (inString && !skipQuote) {
+		// only left when the range ends before len
+		StructuralIndexer rest(json, len);
+		rest.Restrict(indexer.GetEnd(), len, true);
+		if (rest.Next(positions) == 0) {
+			errorOffset = rest.ErrorOffset;
+			return rest.ErrorMessage;
+		}
+		if (!checkEscapes<BuilderT::Strict>(json + stringStart + 1, json + positions[0], hasEscapes)) {
+			errorOffset = stringStart;
+			return "invalid escape sequence in string";
+		}
+		if (!builder.Token(TOKEN_STRING, stringStart, positions[0] + 1 - stringStart, hasEscapes)) {
+			errorOffset = stringStart;
+			return builder.ErrorMessage;
+		}
+	}
+	if (!builder.Finish()) {
+		errorOffset = len;
+		return builder.ErrorMessage;
+	}
+	return 0;
+}
+
+} // namespace json16
+
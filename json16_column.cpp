@@ -0,0 +1,381 @@
+#include "json16_column.h"
+#include "json16_tape.h"
+#include "json16_number.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace json16 {
+
+static const char* const wrongType = "value has the wrong type";
+static const char* const notInteger = "number is not an integer in range";
+static const char* const outOfMemory = "out of memory";
+
+// the offsets of a string column without rows
+static const int32_t noOffsets[1] = { 0 };
+
+static inline
+void setBit(uint8_t* bits, size_t i, bool value)
+{
+	uint8_t mask = (uint8_t)(1 << (i % 8));
+	if (value) {
+		bits[i / 8] |= mask;
+	}else {
+		bits[i / 8] &= (uint8_t)~mask;
+	}
+}
+
+// the column names as bind fields, offset is the column
+static
+BindField* makeFields(const ColumnSpec* specs, size_t count)
+{
+	BindField* fields = (BindField*) malloc((count ? count : 1) * sizeof(BindField));
+	if (!fields) {
+		return 0;
+	}
+	for (size_t i=0; i<count; ++i) {
+		BindField& field = fields[i];
+		field.name = specs[i].name;
+		field.nameLength = specs[i].nameLength;
+		field.offset = i;
+		field.kind = Bind_double;
+		field.size = 0;
+		field.nested = 0;
+		field.optional = true;
+	}
+	return fields;
+}
+
+ColumnExtractor::ColumnExtractor(const ColumnSpec* specs, size_t count)
+	:
+	ErrorMessage(0),
+	ErrorRow(0),
+	specs(specs),
+	count(count),
+	fields(makeFields(specs, count)),
+	table(fields, fields ? count : 0),
+	buffers(0),
+	rowCount(0),
+	rowCapacity(0)
+{
+	if (!fields) {
+		ErrorMessage = outOfMemory;
+		return;
+	}
+	if (table.ErrorMessage) {
+		ErrorMessage = table.ErrorMessage;
+		return;
+	}
+	buffers = (Buffers*) calloc(count ? count : 1, sizeof(Buffers));
+	if (!buffers) {
+		ErrorMessage = outOfMemory;
+	}
+}
+
+ColumnExtractor::~ColumnExtractor()
+{
+	if (buffers) {
+		for (size_t i=0; i<count; ++i) {
+			free(buffers[i].validity);
+			free(buffers[i].values);
+			free(buffers[i].data);
+		}
+		free(buffers);
+	}
+	free(fields);
+}
+
+void ColumnExtractor::Reset()
+{
+	rowCount = 0;
+	if (buffers) {
+		for (size_t i=0; i<count; ++i) {
+			buffers[i].dataLength = 0;
+			buffers[i].nullCount = 0;
+		}
+		ErrorMessage = 0;
+	}
+	ErrorRow = 0;
+}
+
+Column ColumnExtractor::GetColumn(size_t i) const
+{
+	const Buffers& b = buffers[i];
+	Column c;
+	c.kind = specs[i].kind;
+	c.length = rowCount;
+	c.nullCount = b.nullCount;
+	c.validity = b.validity;
+	c.values = b.values;
+	c.data = b.data;
+	c.dataLength = 0;
+	if (c.kind == Column_string) {
+		if (!b.values) {
+			c.values = noOffsets;
+		}else {
+			// not what a row that failed left behind
+			c.dataLength = ((const int32_t*) b.values)[rowCount];
+		}
+	}
+	return c;
+}
+
+// Grows the buffers of every column to rows rows, whole bytes of bits
+// with the bits behind the rows cleared.
+bool ColumnExtractor::reserveRows(size_t rows)
+{
+	if (rows <= rowCapacity) {
+		return true;
+	}
+	size_t newCapacity = rowCapacity * 2;
+	if (newCapacity < rows) {
+		newCapacity = rows;
+	}
+	newCapacity = (newCapacity + 63) & ~(size_t)63;
+	for (size_t i=0; i<count; ++i) {
+		Buffers& b = buffers[i];
+		uint8_t* validity = (uint8_t*) realloc(b.validity, newCapacity / 8);
+		if (!validity) {
+			return false;
+		}
+		memset(validity + rowCapacity / 8, 0, (newCapacity - rowCapacity) / 8);
+		b.validity = validity;
+		size_t valueSize;
+		switch (specs[i].kind) {
+		case Column_double: valueSize = newCapacity * sizeof(double); break;
+		case Column_int64: valueSize = newCapacity * sizeof(int64_t); break;
+		case Column_bool: valueSize = newCapacity / 8; break;
+		default: valueSize = (newCapacity + 1) * sizeof(int32_t); break;
+		}
+		void* values = realloc(b.values, valueSize);
+		if (!values) {
+			return false;
+		}
+		if (specs[i].kind == Column_bool) {
+			memset((uint8_t*)values + rowCapacity / 8, 0, (newCapacity - rowCapacity) / 8);
+		}else if (specs[i].kind == Column_string && !b.values) {
+			((int32_t*)values)[0] = 0;
+		}
+		b.values = values;
+	}
+	rowCapacity = newCapacity;
+	return true;
+}
+
+// room for len bytes of string data, as far as int32_t offsets reach
+bool ColumnExtractor::reserveData(Buffers& b, size_t len)
+{
+	if (b.data && len <= b.dataCapacity) {
+		return true;
+	}
+	if (len > 0x7FFFFFFF) {
+		ErrorMessage = "string column too large for int32 offsets";
+		return false;
+	}
+	size_t newCapacity = b.dataCapacity * 2;
+	if (newCapacity < len) {
+		newCapacity = len;
+	}
+	if (newCapacity < 256) {
+		newCapacity = 256;
+	}
+	char* data = (char*) realloc(b.data, newCapacity);
+	if (!data) {
+		ErrorMessage = outOfMemory;
+		return false;
+	}
+	b.data = data;
+	b.dataCapacity = newCapacity;
+	return true;
+}
+
+// Writes the members of the object at offset into row rowCount. The row only
+// counts once all of them are in, a row that fails is written over by the next.
+template <typename OffsetT>
+bool ColumnExtractor::appendRow(const char* src, const OffsetT* tape, size_t offset)
+{
+	const size_t row = rowCount;
+	ErrorRow = row;
+	if (getValueType(&tape[offset]) != Type_object) {
+		ErrorMessage = wrongType;
+		return false;
+	}
+	if (!reserveRows(row + 1)) {
+		ErrorMessage = outOfMemory;
+		return false;
+	}
+	memset(seen, 0, sizeof(seen));
+	size_t memberCount = getCount(tape[offset]);
+	size_t pos = offset + 2;
+	for (size_t i=0; i<memberCount; ++i) {
+		const BindField* field = table.Find(getStringRef(&tape[pos], src));
+		pos += 2;
+		Type type = getValueType(&tape[pos]);
+		if (field && type != Type_null) {
+			size_t c = field->offset;
+			Buffers& b = buffers[c];
+			const char* err = 0;
+			switch (specs[c].kind) {
+			case Column_double:
+				if (type != Type_number) {
+					err = wrongType;
+				}else {
+					size_t len;
+					const char* p = getNumberText(&tape[pos], src, len);
+					((double*) b.values)[row] = ParseDouble(p, len);
+				}
+				break;
+			case Column_int64:
+				if (type != Type_number) {
+					err = wrongType;
+				}else {
+					size_t len;
+					const char* p = getNumberText(&tape[pos], src, len);
+					if (!ParseInt64(p, len, ((int64_t*) b.values)[row])) {
+						err = notInteger;
+					}
+				}
+				break;
+			case Column_bool:
+				if (type != Type_true && type != Type_false) {
+					err = wrongType;
+				}else {
+					setBit((uint8_t*) b.values, row, type == Type_true);
+				}
+				break;
+			case Column_string:
+				if (type != Type_string) {
+					err = wrongType;
+				}else {
+					// a duplicate replaces what an earlier one wrote
+					StringRef s = getStringRef(&tape[pos], src);
+					size_t begin = ((const int32_t*) b.values)[row];
+					if (!reserveData(b, begin + s.length)) {
+						return false;
+					}
+					if (s.hasEscapes) {
+						b.dataLength = begin + Unescape(s, b.data + begin);
+					}else {
+						memcpy(b.data + begin, s.ptr, s.length);
+						b.dataLength = begin + s.length;
+					}
+				}
+				break;
+			}
+			if (err) {
+				ErrorMessage = err;
+				return false;
+			}
+			seen[c / 64] |= (uint64_t)1 << (c % 64);
+		}
+		pos += entrySize(&tape[pos]);
+	}
+	for (size_t c=0; c<count; ++c) {
+		Buffers& b = buffers[c];
+		bool isSet = (seen[c / 64] >> (c % 64)) & 1;
+		setBit(b.validity, row, isSet);
+		if (!isSet) {
+			++b.nullCount;
+		}
+		switch (specs[c].kind) {
+		case Column_double:
+			if (!isSet) {
+				((double*) b.values)[row] = 0;
+			}
+			break;
+		case Column_int64:
+			if (!isSet) {
+				((int64_t*) b.values)[row] = 0;
+			}
+			break;
+		case Column_bool:
+			if (!isSet) {
+				setBit((uint8_t*) b.values, row, false);
+			}
+			break;
+		case Column_string:
+			{
+				int32_t* offsets = (int32_t*) b.values;
+				offsets[row + 1] = isSet ? (int32_t) b.dataLength : offsets[row];
+			}
+			break;
+		}
+	}
+	++rowCount;
+	return true;
+}
+
+template <typename OffsetT>
+bool ColumnExtractor::AppendRow(const ObjectReaderT<OffsetT>& reader)
+{
+	if (!buffers) {
+		return false;
+	}
+	ErrorMessage = 0;
+	return appendRow(reader.GetSource(), reader.GetTape(), reader.GetTapeOffset());
+}
+
+template <typename OffsetT>
+bool ColumnExtractor::Append(const ArrayReaderT<OffsetT>& reader)
+{
+	if (!buffers) {
+		return false;
+	}
+	ErrorMessage = 0;
+	const char* src = reader.GetSource();
+	const OffsetT* tape = reader.GetTape();
+	size_t offset = reader.GetTapeOffset();
+	size_t elementCount = getCount(tape[offset]);
+	if (!reserveRows(rowCount + elementCount)) {
+		ErrorMessage = outOfMemory;
+		ErrorRow = rowCount;
+		return false;
+	}
+	size_t pos = offset + 2;
+	for (size_t i=0; i<elementCount; ++i) {
+		if (!appendRow(src, tape, pos)) {
+			return false;
+		}
+		pos += entrySize(&tape[pos]);
+	}
+	return true;
+}
+
+template <typename OffsetT>
+bool ColumnExtractor::Append(const NdjsonBatchT<OffsetT>& batch)
+{
+	if (!buffers) {
+		return false;
+	}
+	ErrorMessage = 0;
+	size_t recordCount = batch.GetRecordCount();
+	if (!reserveRows(rowCount + recordCount)) {
+		ErrorMessage = outOfMemory;
+		ErrorRow = rowCount;
+		return false;
+	}
+	for (size_t i=0; i<recordCount; ++i) {
+		const NdjsonRecord& record = batch.GetRecord(i);
+		if (record.ErrorMessage) {
+			ErrorMessage = record.ErrorMessage;
+			ErrorRow = rowCount;
+			return false;
+		}
+		ObjectReaderT<OffsetT> reader = batch.GetParser(i).GetObject();
+		if (!appendRow(reader.GetSource(), reader.GetTape(), 0)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template bool ColumnExtractor::AppendRow(const ObjectReaderT<uint16_t>& reader);
+template bool ColumnExtractor::Append(const ArrayReaderT<uint16_t>& reader);
+template bool ColumnExtractor::Append(const NdjsonBatchT<uint16_t>& batch);
+
+template bool ColumnExtractor::AppendRow(const ObjectReaderT<uint32_t>& reader);
+template bool ColumnExtractor::Append(const ArrayReaderT<uint32_t>& reader);
+template bool ColumnExtractor::Append(const NdjsonBatchT<uint32_t>& batch);
+
+} // namespace json16
+
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "json16.h"
+#include "json16_bind.h"
+#include "json16_ndjson.h"
+
+namespace json16 {
+
+/*
+
+Reshapes arrays of objects, or a batch of NDJSON records, into columns:
+
+	[{"ts":1700000000,"host":"a","value":0.5}, {"ts":1700000001,"host":"b"}]
+
+	static const ColumnSpec specs[] = {
+		{ "ts", 2, Column_int64 },
+		{ "host", 4, Column_string },
+		{ "value", 5, Column_double },
+	};
+	ColumnExtractor columns(specs, 3);
+	columns.Append(parser.GetArray());
+	Column value = columns.GetColumn(2);	// 0.5, null
+
+Every object is one row and every member is looked up once, through the
+perfect hash of BindTable, and its value written straight into the buffer
+of its column. Members without a column are skipped, a later duplicate
+overwrites an earlier one. A missing or null member leaves the row null in
+its column; a value of another type is an error, as for Bind.
+
+The buffers have the layout of Arrow arrays, so that they can be handed on
+as the buffers of the Arrow C data interface:
+
+	validity		bit per row, least significant bit first, set when not null
+	Column_double	double per row
+	Column_int64	int64_t per row
+	Column_bool		bit per row, like validity
+	Column_string	int32_t offsets, one per row and one behind the last, into
+					data, which holds the unescaped UTF-8 of every row
+
+Null rows are 0 in the value buffers and empty in string columns.
+
+*/
+
+enum ColumnKind {
+	Column_double,
+	Column_int64,
+	Column_bool,
+	Column_string,
+};
+
+struct ColumnSpec
+{
+	const char* name;		// unescaped
+	size_t nameLength;
+	ColumnKind kind;
+};
+
+// the buffers of a column, valid until the next Append or Reset
+struct Column
+{
+	ColumnKind kind;
+	size_t length;			// rows
+	size_t nullCount;
+	const uint8_t* validity;
+	const void* values;		// double, int64_t, bits or int32_t offsets
+	const char* data;		// Column_string
+	size_t dataLength;
+};
+
+struct ColumnExtractor
+{
+public:
+	// Specs must outlive the extractor. ErrorMessage is set when there are more
+	// than BindTable::MaxFields of them or memory runs out, nothing can be
+	// appended then.
+	ColumnExtractor(const ColumnSpec* specs, size_t count);
+	~ColumnExtractor();
+	
+	// Appends a row for every element of the array, which have to be objects.
+	// Returns false once ErrorMessage is set, ErrorRow is the row then; the
+	// rows in front of it stay.
+	template <typename OffsetT>
+	bool Append(const ArrayReaderT<OffsetT>& reader);
+	// appends a row for every record of the batch, see above
+	template <typename OffsetT>
+	bool Append(const NdjsonBatchT<OffsetT>& batch);
+	template <typename OffsetT>
+	bool AppendRow(const ObjectReaderT<OffsetT>& reader);
+	// drops all rows, keeps the memory
+	void Reset();
+	
+	size_t GetRowCount() const { return rowCount; }
+	size_t GetColumnCount() const { return count; }
+	Column GetColumn(size_t i) const;
+	
+	const char* ErrorMessage;
+	size_t ErrorRow;
+private:
+	ColumnExtractor(const ColumnExtractor&);
+	ColumnExtractor& operator=(const ColumnExtractor&);
+	
+	struct Buffers
+	{
+		uint8_t* validity;
+		void* values;
+		char* data;
+		size_t dataLength;
+		size_t dataCapacity;
+		size_t nullCount;
+	};
+	
+	bool reserveRows(size_t rows);
+	bool reserveData(Buffers& b, size_t len);
+	template <typename OffsetT>
+	bool appendRow(const char* src, const OffsetT* tape, size_t offset);
+	
+	const ColumnSpec* specs;
+	size_t count;
+	BindField* fields;		// the names of the columns for table
+	BindTable table;
+	Buffers* buffers;
+	size_t rowCount;
+	size_t rowCapacity;
+	uint64_t seen[BindTable::MaxFields / 64];	// columns the current row has a value for
+};
+
+} // namespace json16
+
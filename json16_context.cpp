@@ -0,0 +1,180 @@
+#include "json16_context.h"
+#include "json16_parallel.h"
+#include "json16_tape.h"
+#include "json16_thread.h"
+
+#include <stdlib.h>
+
+namespace json16 {
+
+template <typename OffsetT>
+TapeArenaT<OffsetT>::TapeArenaT(size_t initialWords)
+	:
+	memory(0),
+	capacity(0),
+	used(0)
+{
+	if (initialWords) {
+		Reserve(initialWords);
+	}
+}
+
+template <typename OffsetT>
+TapeArenaT<OffsetT>::~TapeArenaT()
+{
+	free(memory);
+}
+
+template <typename OffsetT>
+bool TapeArenaT<OffsetT>::Reserve(size_t words)
+{
+	if (capacity - used >= words) {
+		return true;
+	}
+	size_t newCapacity = capacity * 2;
+	if (newCapacity - used < words) {
+		newCapacity = used + words;
+	}
+	if (newCapacity > (size_t)-1 / sizeof(OffsetT)) {
+		return false;
+	}
+	OffsetT* p;
+	if (used) {
+		p = (OffsetT*) realloc(memory, newCapacity * sizeof(OffsetT));
+	}else {
+		// nothing to keep, skip the copy realloc would make
+		p = (OffsetT*) malloc(newCapacity * sizeof(OffsetT));
+		if (p) {
+			free(memory);
+		}
+	}
+	if (!p) {
+		return false;
+	}
+	memory = p;
+	capacity = newCapacity;
+	return true;
+}
+
+template <typename OffsetT>
+OffsetT* TapeArenaT<OffsetT>::Allocate(size_t words)
+{
+	if (!Reserve(words)) {
+		return 0;
+	}
+	OffsetT* p = memory + used;
+	used += words;
+	return p;
+}
+
+template <typename OffsetT>
+void TapeArenaT<OffsetT>::Release()
+{
+	free(memory);
+	memory = 0;
+	capacity = 0;
+	used = 0;
+}
+
+template <typename OffsetT>
+ParserContextT<OffsetT>::ParserContextT(bool buildSideIndex, size_t objectThreshold, size_t arrayThreshold)
+	:
+	ErrorMessage(0),
+	buildSideIndex(buildSideIndex),
+	objectThreshold(objectThreshold),
+	arrayThreshold(arrayThreshold),
+	json(0),
+	tape(0),
+	index(0)
+{
+}
+
+template <typename OffsetT>
+bool ParserContextT<OffsetT>::Parse(const char* json, size_t len)
+{
+	return parse(json, len, 1);
+}
+
+template <typename OffsetT>
+bool ParserContextT<OffsetT>::ParseParallel(const char* json, size_t len, size_t threadCount)
+{
+	if (threadCount == 0) {
+		threadCount = GetProcessorCount();
+		if (threadCount > len / ParallelMinChunkSize) {
+			threadCount = len / ParallelMinChunkSize;
+		}
+	}
+	return parse(json, len, threadCount);
+}
+
+template <typename OffsetT>
+bool ParserContextT<OffsetT>::parse(const char* json, size_t len, size_t chunkCount)
+{
+	Reset();
+	if (len > TapeLimits<OffsetT>::MaxPosition) {
+		ErrorMessage = "document too large for tape offset width";
+		return false;
+	}
+	size_t tapeWords = TapeSizeBound(len);
+	size_t indexWords = buildSideIndex ? SideIndexSizeBound(len, objectThreshold, arrayThreshold) : 0;
+	if (!arena.Reserve(tapeWords + indexWords)) {
+		ErrorMessage = "out of memory";
+		return false;
+	}
+	OffsetT* work = arena.Allocate(tapeWords);
+	SideIndexT<OffsetT> sideIndex(arena.Allocate(indexWords), indexWords, objectThreshold, arrayThreshold);
+	if (chunkCount > 1 && ParseChunked(json, len, work, chunkArena, chunkCount)) {
+		if (buildSideIndex && !BuildSideIndex(json, (const OffsetT*)work, sideIndex)) {
+			ErrorMessage = "side index capacity too small";
+			return false;
+		}
+	}else {
+		// also gives the error of a document the chunks could not take
+		ParserT<OffsetT> parser(json, len, work, buildSideIndex ? &sideIndex : 0);
+		if (parser.ErrorMessage) {
+			ErrorMessage = parser.ErrorMessage;
+			return false;
+		}
+	}
+	this->json = json;
+	tape = work;
+	index = buildSideIndex ? sideIndex.memory : 0;
+	return true;
+}
+
+template <typename OffsetT>
+void ParserContextT<OffsetT>::Reset()
+{
+	arena.Reset();
+	ErrorMessage = 0;
+	json = 0;
+	tape = 0;
+	index = 0;
+}
+
+template <typename OffsetT>
+Type ParserContextT<OffsetT>::GetValueType() const
+{
+	return getValueType(tape);
+}
+
+template <typename OffsetT>
+ObjectReaderT<OffsetT> ParserContextT<OffsetT>::GetObject() const
+{
+	return ObjectReaderT<OffsetT>(0, json, tape, index);
+}
+
+template <typename OffsetT>
+ArrayReaderT<OffsetT> ParserContextT<OffsetT>::GetArray() const
+{
+	return ArrayReaderT<OffsetT>(0, json, tape, index);
+}
+
+template struct TapeArenaT<uint16_t>;
+template struct ParserContextT<uint16_t>;
+
+template struct TapeArenaT<uint32_t>;
+template struct ParserContextT<uint32_t>;
+
+} // namespace json16
+
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "json16.h"
+
+namespace json16 {
+
+// One growing block of OffsetT words handed out front to back.
+// Reset makes all of it free again without touching the memory, so a block
+// sized for the largest document seen so far serves every later one.
+template <typename OffsetT>
+struct TapeArenaT
+{
+public:
+	TapeArenaT(size_t initialWords = 0);
+	~TapeArenaT();
+	
+	// Returns room for words more words, uninitialized; 0 when the block cannot grow.
+	// Growing moves the block, which invalidates earlier allocations.
+	OffsetT* Allocate(size_t words);
+	// grows the block so that words more words fit, see Allocate
+	bool Reserve(size_t words);
+	void Reset() { used = 0; }
+	// gives the last words words handed out back
+	void Trim(size_t words) { used -= words; }
+	// frees the block
+	void Release();
+	
+	size_t GetCapacity() const { return capacity; }
+	// start of the block, allocations are offsets from it once it may have moved
+	const OffsetT* GetMemory() const { return memory; }
+	OffsetT* GetMemory() { return memory; }
+	size_t GetUsed() const { return used; }
+private:
+	TapeArenaT(const TapeArenaT&);
+	TapeArenaT& operator=(const TapeArenaT&);
+	
+	OffsetT* memory;
+	size_t capacity;	// in words
+	size_t used;
+};
+
+// Parses one document after another into memory it keeps.
+// Every Parse sizes the arena with TapeSizeBound / SideIndexSizeBound from
+// the input length, so no buffer size has to be guessed and memory is only
+// allocated while documents keep getting larger.
+// The readers of a document stay valid until the next Parse or Reset.
+template <typename OffsetT>
+struct ParserContextT
+{
+public:
+	// buildSideIndex adds hash tables for objects with at least objectThreshold
+	// members and element tables for arrays with at least arrayThreshold
+	// elements, see SideIndexT
+	ParserContextT(bool buildSideIndex = false, size_t objectThreshold = 32, size_t arrayThreshold = 0);
+	
+	// returns false once ErrorMessage is set
+	bool Parse(const char* json, size_t len);
+	// Parses a large document on threadCount threads, see ParseChunked in
+	// json16_parallel.h. 0 picks one per processor, as far as the input
+	// gives each of them ParallelMinChunkSize bytes.
+	bool ParseParallel(const char* json, size_t len, size_t threadCount = 0);
+	// forgets the current document, keeps the memory
+	void Reset();
+	
+	Type GetValueType() const;
+	ObjectReaderT<OffsetT> GetObject() const;
+	ArrayReaderT<OffsetT> GetArray() const;
+	const OffsetT* GetTape() const { return tape; }
+	const OffsetT* GetIndex() const { return index; }
+	TapeArenaT<OffsetT>& GetArena() { return arena; }
+	
+	const char* ErrorMessage;
+private:
+	ParserContextT(const ParserContextT&);
+	ParserContextT& operator=(const ParserContextT&);
+	
+	bool parse(const char* json, size_t len, size_t chunkCount);
+	
+	TapeArenaT<OffsetT> arena;
+	TapeArenaT<OffsetT> chunkArena;		// partial tapes of ParseParallel
+	bool buildSideIndex;
+	size_t objectThreshold;
+	size_t arrayThreshold;
+	const char* json;
+	const OffsetT* tape;
+	const OffsetT* index;
+};
+
+typedef TapeArenaT<uint16_t> TapeArena;
+typedef TapeArenaT<uint32_t> TapeArena32;
+typedef ParserContextT<uint16_t> ParserContext;
+typedef ParserContextT<uint32_t> ParserContext32;
+
+} // namespace json16
+
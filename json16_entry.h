@@ -0,0 +1,111 @@
+#pragma once
+
+#include "json16.h"
+
+namespace json16 {
+
+// Layout of a tape entry and the reads of it that json16_tape.h builds on,
+// see there. Kept apart so that the iterators of json16_range.h inline them
+// without the rest of the internals; nothing in here is part of the API.
+namespace detail {
+
+template <typename OffsetT>
+struct ValueHeader
+{
+	OffsetT position : sizeof(OffsetT)*8-1;
+	OffsetT isContainer : 1;
+};
+
+template <typename OffsetT>
+struct ScalarInfo
+{
+	OffsetT length : sizeof(OffsetT)*8-4;
+	OffsetT hasEscapes : 1;
+	OffsetT type : 3;
+};
+
+template <typename OffsetT>
+struct ContainerHeader
+{
+	OffsetT count : sizeof(OffsetT)*8-2;
+	OffsetT isObject : 1;
+	OffsetT isContainer : 1;
+	OffsetT size;
+};
+
+template <typename OffsetT>
+struct TapeLimits
+{
+	static const size_t MaxPosition = ((size_t)1 << (sizeof(OffsetT)*8-1)) - 1;
+	static const size_t MaxCount = ((size_t)1 << (sizeof(OffsetT)*8-2)) - 1;
+	static const size_t MaxSize = (size_t)(OffsetT)~0;
+	static const size_t MaxLength = ((size_t)1 << (sizeof(OffsetT)*8-4)) - 1;
+};
+
+// length of a token whose length did not fit ScalarInfo, scanned in json16.cpp
+size_t scanTokenLength(const char* token);
+
+template <typename OffsetT>
+inline
+Type valueType(const OffsetT* entry)
+{
+	ValueHeader<OffsetT> v = *(const ValueHeader<OffsetT>*) entry;
+	if (v.isContainer) {
+		ContainerHeader<OffsetT> c = *(const ContainerHeader<OffsetT>*) entry;
+		return c.isObject ? Type_object : Type_array;
+	}else {
+		ScalarInfo<OffsetT> si = *(const ScalarInfo<OffsetT>*) &entry[1];
+		return (Type) si.type;
+	}
+}
+
+template <typename OffsetT>
+inline
+size_t tokenLength(const OffsetT* entry, const char* src)
+{
+	ValueHeader<OffsetT> v = *(const ValueHeader<OffsetT>*) entry;
+	ScalarInfo<OffsetT> si = *(const ScalarInfo<OffsetT>*) &entry[1];
+	if (si.length != TapeLimits<OffsetT>::MaxLength) {
+		return si.length;
+	}
+	// only very long strings do not fit
+	return scanTokenLength(src + v.position);
+}
+
+template <typename OffsetT>
+inline
+StringRef stringValue(const OffsetT* entry, const char* src)
+{
+	ValueHeader<OffsetT> v = *(const ValueHeader<OffsetT>*) entry;
+	ScalarInfo<OffsetT> si = *(const ScalarInfo<OffsetT>*) &entry[1];
+	StringRef s;
+	s.ptr = src + v.position + 1;
+	s.length = tokenLength(entry, src) - 2;
+	s.hasEscapes = si.hasEscapes;
+	return s;
+}
+
+template <typename OffsetT>
+inline
+const char* numberText(const OffsetT* entry, const char* src, size_t& length)
+{
+	ValueHeader<OffsetT> v = *(const ValueHeader<OffsetT>*) entry;
+	length = tokenLength(entry, src);
+	return src + v.position;
+}
+
+template <typename OffsetT>
+inline
+size_t entrySize(const OffsetT* entry)
+{
+	ValueHeader<OffsetT> vh = *(const ValueHeader<OffsetT>*) entry;
+	if (vh.isContainer) {
+		return ((const ContainerHeader<OffsetT>*) entry)->size;
+	}
+	return 2;
+}
+
+} // namespace detail
+
+} // namespace json16
+
@@ -0,0 +1,319 @@
+#include "json16_image.h"
+#include "json16_tape.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+// wingdi.h maps GetObject to GetObjectA/W
+#undef GetObject
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace json16 {
+
+static const uint32_t ImageMagic = 'J' | ('1' << 8) | ('6' << 16) | ('I' << 24);
+static const int TapeRevision = 3;
+
+struct ImageHeader
+{
+	uint32_t magic;
+	uint8_t version;
+	uint8_t offsetWidth;
+	uint8_t tapeRevision;
+	uint8_t reserved0;
+	uint32_t sourceLength;
+	uint32_t tapeWords;
+	uint32_t indexWords;
+	uint32_t reserved1;
+	uint64_t checksum;
+};
+
+static inline
+size_t padTo8(size_t n)
+{
+	return (n + 7) & ~(size_t)7;
+}
+
+// multiply-xor hash over 8 byte words, a partial last word is zero padded
+struct ImageChecksum
+{
+	ImageChecksum()
+		:
+		hash(0x9E3779B97F4A7C15ULL)
+	{
+	}
+	
+	void Add(const void* data, size_t len)
+	{
+		const char* p = (const char*) data;
+		const char* end = p + (len & ~(size_t)7);
+		for (; p != end; p += 8) {
+			uint64_t w;
+			memcpy(&w, p, 8);
+			mix(w);
+		}
+		if (len & 7) {
+			uint64_t w = 0;
+			memcpy(&w, p, len & 7);
+			mix(w);
+		}
+	}
+	
+	uint64_t hash;
+	
+private:
+	void mix(uint64_t w)
+	{
+		hash = (hash ^ w) * 0x100000001B3ULL;
+		hash ^= hash >> 29;
+	}
+};
+
+// words the side index occupies, tables are laid out in order
+template <typename OffsetT>
+static
+size_t sideIndexWords(const OffsetT* index)
+{
+	size_t tableCount = index[0];
+	if (tableCount == 0) {
+		return 1;
+	}
+	size_t last = index[tableCount * 2];
+	return last + 1 + index[last];
+}
+
+template <typename OffsetT>
+bool WriteImage(OutputSink& sink, const ParserT<OffsetT>& parser, const char* json, size_t len)
+{
+	if (parser.ErrorMessage) {
+		return false;
+	}
+	ObjectReaderT<OffsetT> root = parser.GetObject();
+	const OffsetT* tape = root.GetTape();
+	const OffsetT* index = root.GetIndex();
+	size_t tapeBytes = entrySize(tape) * sizeof(OffsetT);
+	size_t indexBytes = index ? sideIndexWords(index) * sizeof(OffsetT) : 0;
+	// the source always gets a terminating zero
+	size_t sourcePadding = padTo8(len + 1) - len;
+	static const char zeros[8] = {0};
+	
+	// same bytes as they follow the header in the file
+	ImageChecksum sum;
+	sum.Add(json, len);
+	if (!(len & 7)) {
+		sum.Add(zeros, 8);
+	}
+	sum.Add(tape, tapeBytes);
+	sum.Add(index, indexBytes);
+	
+	ImageHeader hdr;
+	memset(&hdr, 0, sizeof(hdr));
+	hdr.magic = ImageMagic;
+	hdr.version = ImageVersion;
+	hdr.offsetWidth = sizeof(OffsetT);
+	hdr.tapeRevision = TapeRevision;
+	hdr.sourceLength = (uint32_t)len;
+	hdr.tapeWords = (uint32_t)(tapeBytes / sizeof(OffsetT));
+	hdr.indexWords = (uint32_t)(indexBytes / sizeof(OffsetT));
+	hdr.checksum = sum.hash;
+	
+	sink.Write((const char*)&hdr, sizeof(hdr));
+	sink.Write(json, len);
+	sink.Write(zeros, sourcePadding);
+	sink.Write((const char*)tape, tapeBytes);
+	sink.Write(zeros, padTo8(tapeBytes) - tapeBytes);
+	if (indexBytes) {
+		sink.Write((const char*)index, indexBytes);
+		sink.Write(zeros, padTo8(indexBytes) - indexBytes);
+	}
+	return !sink.Failed();
+}
+
+template <typename OffsetT>
+MappedImageT<OffsetT>::MappedImageT()
+	:
+	ErrorMessage(0),
+	source(0),
+	sourceLength(0),
+	tape(0),
+	index(0),
+	mapping(0),
+	mappingSize(0)
+#ifdef _WIN32
+	, mappingHandle(0)
+#endif
+{
+}
+
+template <typename OffsetT>
+MappedImageT<OffsetT>::~MappedImageT()
+{
+	Close();
+}
+
+template <typename OffsetT>
+bool MappedImageT<OffsetT>::Open(const char* path, bool verify)
+{
+	Close();
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		ErrorMessage = "cannot open image file";
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0 || (uint64_t)fileSize.QuadPart > (size_t)~0) {
+		CloseHandle(file);
+		ErrorMessage = "image is truncated";
+		return false;
+	}
+	HANDLE handle = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if (!handle) {
+		ErrorMessage = "cannot map image file";
+		return false;
+	}
+	void* p = MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+	if (!p) {
+		CloseHandle(handle);
+		ErrorMessage = "cannot map image file";
+		return false;
+	}
+	mappingHandle = handle;
+	size_t size = (size_t)fileSize.QuadPart;
+#else
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		ErrorMessage = "cannot open image file";
+		return false;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		close(fd);
+		ErrorMessage = "image is truncated";
+		return false;
+	}
+	size_t size = (size_t)st.st_size;
+	void* p = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED) {
+		ErrorMessage = "cannot map image file";
+		return false;
+	}
+#endif
+	mapping = p;
+	mappingSize = size;
+	if (!Attach(p, size, verify)) {
+		const char* message = ErrorMessage;
+		Close();
+		ErrorMessage = message;
+		return false;
+	}
+	return true;
+}
+
+template <typename OffsetT>
+bool MappedImageT<OffsetT>::Attach(const void* data, size_t size, bool verify)
+{
+	ErrorMessage = 0;
+	if (size < ImageHeaderSize) {
+		ErrorMessage = "image is truncated";
+		return false;
+	}
+	ImageHeader hdr;
+	memcpy(&hdr, data, sizeof(hdr));
+	if (hdr.magic != ImageMagic) {
+		ErrorMessage = "not an image or written with another byte order";
+		return false;
+	}
+	if (hdr.version != ImageVersion || hdr.tapeRevision != TapeRevision) {
+		ErrorMessage = "unsupported image version";
+		return false;
+	}
+	if (hdr.offsetWidth != sizeof(OffsetT)) {
+		ErrorMessage = "image was written with another tape offset width";
+		return false;
+	}
+	size_t sourceBytes = padTo8((size_t)hdr.sourceLength + 1);
+	size_t tapeBytes = padTo8((size_t)hdr.tapeWords * sizeof(OffsetT));
+	size_t indexBytes = padTo8((size_t)hdr.indexWords * sizeof(OffsetT));
+	if (hdr.sourceLength > TapeLimits<OffsetT>::MaxPosition
+		|| hdr.tapeWords < 2 || hdr.tapeWords > TapeLimits<OffsetT>::MaxSize
+		|| hdr.indexWords > TapeLimits<OffsetT>::MaxSize
+		|| size - ImageHeaderSize < sourceBytes + tapeBytes + indexBytes
+	) {
+		ErrorMessage = "image is truncated";
+		return false;
+	}
+	const char* p = (const char*) data + ImageHeaderSize;
+	if (verify) {
+		ImageChecksum sum;
+		sum.Add(p, sourceBytes + tapeBytes + indexBytes);
+		if (sum.hash != hdr.checksum) {
+			ErrorMessage = "image checksum mismatch";
+			return false;
+		}
+	}
+	const OffsetT* t = (const OffsetT*)(p + sourceBytes);
+	ValueHeader<OffsetT> vh = *(const ValueHeader<OffsetT>*) t;
+	if (!vh.isContainer || entrySize(t) != hdr.tapeWords) {
+		ErrorMessage = "image tape is damaged";
+		return false;
+	}
+	source = p;
+	sourceLength = hdr.sourceLength;
+	tape = t;
+	index = hdr.indexWords ? (const OffsetT*)(p + sourceBytes + tapeBytes) : 0;
+	return true;
+}
+
+template <typename OffsetT>
+void MappedImageT<OffsetT>::Close()
+{
+	if (mapping) {
+#ifdef _WIN32
+		UnmapViewOfFile(mapping);
+		CloseHandle((HANDLE)mappingHandle);
+		mappingHandle = 0;
+#else
+		munmap(mapping, mappingSize);
+#endif
+		mapping = 0;
+		mappingSize = 0;
+	}
+	source = 0;
+	sourceLength = 0;
+	tape = 0;
+	index = 0;
+	ErrorMessage = 0;
+}
+
+template <typename OffsetT>
+Type MappedImageT<OffsetT>::GetValueType() const
+{
+	return getValueType(tape);
+}
+
+template <typename OffsetT>
+ObjectReaderT<OffsetT> MappedImageT<OffsetT>::GetObject() const
+{
+	return ObjectReaderT<OffsetT>(0, source, tape, index);
+}
+
+template <typename OffsetT>
+ArrayReaderT<OffsetT> MappedImageT<OffsetT>::GetArray() const
+{
+	return ArrayReaderT<OffsetT>(0, source, tape, index);
+}
+
+template bool WriteImage(OutputSink& sink, const ParserT<uint16_t>& parser, const char* json, size_t len);
+template bool WriteImage(OutputSink& sink, const ParserT<uint32_t>& parser, const char* json, size_t len);
+template struct MappedImageT<uint16_t>;
+template struct MappedImageT<uint32_t>;
+
+} // namespace json16
+
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "json16.h"
+#include "json16_writer.h"
+
+namespace json16 {
+
+/*
+
+document image : a parsed document stored so that it can be mapped and read in place
+
+	header (32 bytes)
+		magic : "J16I", also tells the byte order
+		version : 1 byte (ImageVersion)
+		offsetWidth : 1 byte (sizeof(OffsetT))
+		tapeRevision : 1 byte (revision of the tape format in json16_tape.h)
+		reserved : 1 byte (0)
+		sourceLength : 4 bytes
+		tapeWords : 4 bytes
+		indexWords : 4 bytes (0 without side index)
+		reserved : 4 bytes (0)
+		checksum : 8 bytes (over everything after the header)
+	source : sourceLength bytes, then zeros up to the next multiple of 8 (at least one)
+	tape : tapeWords OffsetT words, zero padded to a multiple of 8 bytes
+	side index : indexWords OffsetT words, zero padded to a multiple of 8 bytes
+
+The tape is stored as it is in memory, so an image is only readable on the
+byte order and bit-field layout it was written with.
+
+*/
+
+enum {
+	ImageVersion = 1,
+	ImageHeaderSize = 32,
+};
+
+// Writes the document parser has parsed from json/len as an image.
+template <typename OffsetT>
+bool WriteImage(OutputSink& sink, const ParserT<OffsetT>& parser, const char* json, size_t len);
+
+// Read-only view of an image, either mapped from a file or in caller memory.
+// Readers returned from it stay valid until Close.
+template <typename OffsetT>
+struct MappedImageT
+{
+public:
+	MappedImageT();
+	~MappedImageT();
+	
+	// maps the file shared and read-only, verify reads every page for the checksum
+	bool Open(const char* path, bool verify = true);
+	// uses an image that is already in memory, data needs 8 byte alignment
+	bool Attach(const void* data, size_t size, bool verify = true);
+	void Close();
+	
+	Type GetValueType() const;
+	ObjectReaderT<OffsetT> GetObject() const;
+	ArrayReaderT<OffsetT> GetArray() const;
+	const char* GetSource() const { return source; }
+	size_t GetSourceLength() const { return sourceLength; }
+	
+	const char* ErrorMessage;
+private:
+	MappedImageT(const MappedImageT&);
+	MappedImageT& operator=(const MappedImageT&);
+	
+	const char* source;
+	size_t sourceLength;
+	const OffsetT* tape;
+	const OffsetT* index;
+	void* mapping;		// set when Open mapped a file
+	size_t mappingSize;
+#ifdef _WIN32
+	void* mappingHandle;
+#endif
+};
+
+typedef MappedImageT<uint16_t> MappedImage;
+typedef MappedImageT<uint32_t> MappedImage32;
+
+} // namespace json16
+
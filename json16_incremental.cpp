@@ -0,0 +1,380 @@
+#include "json16_incremental.h"
+#include "json16_tape.h"
+#include "json16_indexer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace json16 {
+
+static
+bool reserveBytes(char*& buff, size_t& capacity, size_t len)
+{
+	if (buff && len <= capacity) {
+		return true;
+	}
+	size_t newCapacity = capacity * 2;
+	if (newCapacity < len) {
+		newCapacity = len;
+	}
+	if (newCapacity < 64) {
+		newCapacity = 64;
+	}
+	char* p = (char*) realloc(buff, newCapacity);
+	if (!p) {
+		return false;
+	}
+	buff = p;
+	capacity = newCapacity;
+	return true;
+}
+
+// Start of the member at entry x of the container opening at begin.
+// prev is the value entry of the member in front starting at prevStart, 0 for the first one.
+template <typename OffsetT>
+static
+size_t memberStart(const char* src, size_t len, const OffsetT* tape, size_t begin, size_t x, size_t prev, size_t prevStart)
+{
+	// the name of an object member or a scalar element
+	if (!isContainerEntry(&tape[x])) {
+		return entryPosition(&tape[x]);
+	}
+	size_t p;
+	if (findContainerStart(src, tape, x, p)) {
+		return p;
+	}
+	// nothing but empty containers inside, step over the member in front
+	if (!prev) {
+		return skipSpace(src, len, begin + 1);
+	}
+	if (isContainerEntry(&tape[prev])) {
+		p = FindContainerEnd(src, len, prevStart);
+	}else {
+		p = prevStart + getTokenLength(&tape[prev], src);
+	}
+	p = skipSpace(src, len, p) + 1;
+	return skipSpace(src, len, p);
+}
+
+// nesting of the containers on tape, 1 for a tape without containers inside the root
+template <typename OffsetT>
+static
+size_t tapeDepth(const OffsetT* tape)
+{
+	size_t ends[DefaultMaxDepth + 1];
+	size_t depth = 0;
+	size_t maxDepth = 0;
+	size_t size = entrySize(tape);
+	for (size_t x=0; x<size; x+=2) {
+		while (depth && x == ends[depth - 1]) {
+			--depth;
+		}
+		if (isContainerEntry(&tape[x])) {
+			assert(depth <= DefaultMaxDepth);
+			ends[depth++] = x + entrySize(&tape[x]);
+			if (depth > maxDepth) {
+				maxDepth = depth;
+			}
+		}
+	}
+	return maxDepth;
+}
+
+template <typename OffsetT>
+IncrementalParserT<OffsetT>::IncrementalParserT()
+	:
+	ErrorMessage(0),
+	ErrorOffset(0),
+	text(0),
+	length(0),
+	capacity(0),
+	region(0),
+	regionCapacity(0),
+	valid(false),
+	parsedLength(0)
+{
+}
+
+template <typename OffsetT>
+IncrementalParserT<OffsetT>::~IncrementalParserT()
+{
+	free(text);
+	free(region);
+}
+
+template <typename OffsetT>
+bool IncrementalParserT<OffsetT>::Parse(const char* json, size_t len)
+{
+	ErrorMessage = 0;
+	ErrorOffset = 0;
+	valid = false;
+	tape.Reset();
+	if (!reserveBytes(text, capacity, len)) {
+		length = 0;
+		ErrorMessage = "out of memory";
+		return false;
+	}
+	memcpy(text, json, len);
+	length = len;
+	return parseAll();
+}
+
+template <typename OffsetT>
+bool IncrementalParserT<OffsetT>::Edit(size_t offset, size_t removedLength, const char* inserted, size_t insertedLength)
+{
+	ErrorMessage = 0;
+	ErrorOffset = 0;
+	if (offset > length || removedLength > length - offset) {
+		ErrorMessage = "edit outside the text";
+		ErrorOffset = offset;
+		return false;
+	}
+	size_t newLength = length - removedLength + insertedLength;
+	if (!reserveBytes(text, capacity, newLength)) {
+		ErrorMessage = "out of memory";
+		return false;
+	}
+	// found in the text before the edit, innermost last
+	Level levels[DefaultMaxDepth];
+	size_t depth = 0;
+	if (valid && newLength <= TapeLimits<OffsetT>::MaxPosition) {
+		depth = findLevels(offset, removedLength, levels);
+	}
+	memmove(text + offset + insertedLength, text + offset + removedLength, length - offset - removedLength);
+	if (insertedLength) {
+		memcpy(text + offset, inserted, insertedLength);
+	}
+	length = newLength;
+	while (depth) {
+		--depth;
+		if (splice(levels, depth, removedLength, insertedLength)) {
+			return true;
+		}
+	}
+	return parseAll();
+}
+
+template <typename OffsetT>
+Type IncrementalParserT<OffsetT>::GetValueType() const
+{
+	return getValueType(tape.GetMemory());
+}
+
+template <typename OffsetT>
+ObjectReaderT<OffsetT> IncrementalParserT<OffsetT>::GetObject() const
+{
+	return ObjectReaderT<OffsetT>(0, text, tape.GetMemory());
+}
+
+template <typename OffsetT>
+ArrayReaderT<OffsetT> IncrementalParserT<OffsetT>::GetArray() const
+{
+	return ArrayReaderT<OffsetT>(0, text, tape.GetMemory());
+}
+
+template <typename OffsetT>
+bool IncrementalParserT<OffsetT>::parseAll()
+{
+	valid = false;
+	tape.Reset();
+	parsedLength = length;
+	if (length > TapeLimits<OffsetT>::MaxPosition) {
+		ErrorMessage = "document too large for tape offset width";
+		return false;
+	}
+	size_t words = TapeSizeBound(length);
+	OffsetT* w = tape.Allocate(words);
+	if (!w) {
+		ErrorMessage = "out of memory";
+		return false;
+	}
+	ParserT<OffsetT> parser(text, length, w);
+	if (parser.ErrorMessage) {
+		ErrorMessage = parser.ErrorMessage;
+		ErrorOffset = parser.ErrorOffset;
+		tape.Reset();
+		return false;
+	}
+	tape.Trim(words - w[1]);
+	valid = true;
+	return true;
+}
+
+// Walks down from the root as long as the edit is inside a single container
+// member, not touching its brackets. Every level gets the run of members that
+// starts with the last one starting at or before the edit and ends with the
+// first one ending at or after it. Returns the number of levels, 0 when the
+// edit touches the brackets of the root or the text around them.
+template <typename OffsetT>
+size_t IncrementalParserT<OffsetT>::findLevels(size_t offset, size_t removedLength, Level* levels) const
+{
+	const char* src = text;
+	const OffsetT* t = tape.GetMemory();
+	size_t lo = offset;
+	size_t hi = offset + removedLength;
+	size_t begin = skipSpace(src, length, 0);
+	size_t end = skipSpaceBack(src, length);
+	if (lo <= begin || hi >= end) {
+		return 0;
+	}
+	size_t c = 0;
+	size_t depth = 0;
+	for (;;) {
+		assert(depth < DefaultMaxDepth);
+		Level& level = levels[depth++];
+		bool isObject = isObjectEntry(&t[c]);
+		size_t count = getCount(t[c]);
+		level.entry = c;
+		level.begin = begin;
+		level.end = end;
+		level.first = c + 2;
+		level.last = c + entrySize(&t[c]);
+		level.regionBegin = begin + 1;
+		level.regionEnd = end - 1;
+		size_t firstIndex = count;
+		size_t lastIndex = count;
+		size_t firstValue = 0;
+		size_t x = c + 2;
+		size_t start = count ? memberStart(src, length, t, begin, x, 0, 0) : 0;
+		for (size_t i=0; i<count; ++i) {
+			size_t v = isObject ? x + 2 : x;
+			size_t next = v + entrySize(&t[v]);
+			size_t nextStart = 0;
+			if (i + 1 < count) {
+				nextStart = memberStart(src, length, t, begin, next, v, start);
+			}
+			size_t memberEnd;
+			if (!isContainerEntry(&t[v])) {
+				memberEnd = entryPosition(&t[v]) + getTokenLength(&t[v], src);
+			}else if (i + 1 < count) {
+				// in front of the comma
+				memberEnd = skipSpaceBack(src, skipSpaceBack(src, nextStart) - 1);
+			}else {
+				memberEnd = skipSpaceBack(src, end - 1);
+			}
+			if (start <= lo) {
+				firstIndex = i;
+				firstValue = v;
+				level.first = x;
+				level.regionBegin = start;
+			}
+			if (memberEnd >= hi) {
+				// members behind start after the edit
+				lastIndex = i;
+				level.last = next;
+				level.regionEnd = memberEnd;
+				break;
+			}
+			x = next;
+			start = nextStart;
+		}
+		size_t from = (firstIndex == count) ? 0 : firstIndex;
+		size_t to = (lastIndex == count) ? count : lastIndex + 1;
+		level.memberCount = to - from;
+		level.all = (from == 0 && to == count);
+		if (firstIndex != lastIndex || firstIndex == count || !isContainerEntry(&t[firstValue])) {
+			return depth;
+		}
+		size_t valueBegin = level.regionBegin;
+		if (isObject) {
+			// after the name and the colon
+			size_t p = level.regionBegin + getTokenLength(&t[firstValue - 2], src);
+			p = skipSpace(src, length, p);
+			valueBegin = skipSpace(src, length, p + 1);
+		}
+		size_t valueEnd = level.regionEnd;
+		if (lo <= valueBegin || hi >= valueEnd) {
+			return depth;
+		}
+		c = firstValue;
+		begin = valueBegin;
+		end = valueEnd;
+	}
+}
+
+// Parses the run of members of levels[depth] again and puts them in place of
+// the old ones. False, with the tape as it was, when they do not parse on
+// their own or do not fit the tape.
+template <typename OffsetT>
+bool IncrementalParserT<OffsetT>::splice(const Level* levels, size_t depth, size_t removedLength, size_t insertedLength)
+{
+	const Level& level = levels[depth];
+	bool isObject = isObjectEntry(&tape.GetMemory()[level.entry]);
+	size_t regionBegin = level.regionBegin;
+	size_t regionLength = level.regionEnd - removedLength + insertedLength - regionBegin;
+	if (!reserveBytes(region, regionCapacity, regionLength + 2)) {
+		return false;
+	}
+	region[0] = isObject ? '{' : '[';
+	memcpy(region + 1, text + regionBegin, regionLength);
+	region[regionLength + 1] = isObject ? '}' : ']';
+
+	work.Reset();
+	OffsetT* w = work.Allocate(TapeSizeBound(regionLength + 2));
+	if (!w) {
+		return false;
+	}
+	ParserT<OffsetT> parser(region, regionLength + 2, w);
+	if (parser.ErrorMessage) {
+		return false;
+	}
+	size_t newCount = getCount(w[0]);
+	if (newCount == 0 && !level.all) {
+		// the commas around need a member between them
+		return false;
+	}
+	// the brackets of the region stand for the container
+	if (depth + tapeDepth((const OffsetT*)w) > DefaultMaxDepth) {
+		return false;
+	}
+	const OffsetT* t = tape.GetMemory();
+	size_t oldWords = level.last - level.first;
+	size_t newWords = w[1] - 2;
+	if (getCount(t[level.entry]) - level.memberCount + newCount > TapeLimits<OffsetT>::MaxCount) {
+		return false;
+	}
+	// the root is the largest container
+	if (entrySize(t) - oldWords + newWords > TapeLimits<OffsetT>::MaxSize) {
+		return false;
+	}
+
+	size_t used = tape.GetUsed();
+	if (newWords > oldWords && !tape.Allocate(newWords - oldWords)) {
+		return false;
+	}
+	OffsetT* mt = tape.GetMemory();
+	memmove(mt + level.first + newWords, mt + level.last, (used - level.last) * sizeof(OffsetT));
+	if (newWords < oldWords) {
+		tape.Trim(oldWords - newWords);
+	}
+	// the new members, positions from the region to the text
+	memcpy(mt + level.first, w + 2, newWords * sizeof(OffsetT));
+	for (size_t x=level.first; x<level.first+newWords; x+=2) {
+		ValueHeader<OffsetT>* vh = (ValueHeader<OffsetT>*) &mt[x];
+		if (!vh->isContainer) {
+			vh->position = (OffsetT)(vh->position + regionBegin - 1);
+		}
+	}
+	// everything behind moved in the text
+	size_t newUsed = tape.GetUsed();
+	for (size_t x=level.first+newWords; x<newUsed; x+=2) {
+		ValueHeader<OffsetT>* vh = (ValueHeader<OffsetT>*) &mt[x];
+		if (!vh->isContainer) {
+			vh->position = (OffsetT)(vh->position - removedLength + insertedLength);
+		}
+	}
+	ContainerHeader<OffsetT>* ch = (ContainerHeader<OffsetT>*) &mt[level.entry];
+	ch->count = (OffsetT)(ch->count - level.memberCount + newCount);
+	for (size_t i=0; i<=depth; ++i) {
+		ch = (ContainerHeader<OffsetT>*) &mt[levels[i].entry];
+		ch->size = (OffsetT)(ch->size - oldWords + newWords);
+	}
+	parsedLength = regionLength;
+	return true;
+}
+
+template struct IncrementalParserT<uint16_t>;
+template struct IncrementalParserT<uint32_t>;
+
+} // namespace json16
+
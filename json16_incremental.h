@@ -0,0 +1,93 @@
+#pragma once
+
+#include "json16.h"
+#include "json16_context.h"
+
+namespace json16 {
+
+/*
+
+Keeps a document and its tape up to date while the text is edited, for
+editors that want a tape after every keystroke.
+
+An edit replaces removedLength bytes at offset with new bytes. The tape is
+walked down from the root to the innermost container the edit is inside of,
+stepping over the members in front of it. Only the members of that container
+the edit touches are parsed again, wrapped in brackets of their own, and
+their tape words take the place of the old ones; the count of the container
+and the size of it and of every container around it change accordingly.
+The tape words behind move and their positions shift by the change in
+length, one pass over the words that does not look at the text.
+
+When the new members do not parse on their own, for instance because a
+bracket or a quote was typed that reaches beyond them, the members around
+the container are tried next, up to the whole document.
+
+*/
+
+template <typename OffsetT>
+struct IncrementalParserT
+{
+public:
+	IncrementalParserT();
+	~IncrementalParserT();
+	
+	// copies the text and parses all of it, returns false once ErrorMessage is set
+	bool Parse(const char* json, size_t len);
+	// Replaces removedLength bytes at offset with inserted, which may not point
+	// into GetText(), and updates the tape. Returns false once ErrorMessage is
+	// set; unless the edit is out of range or memory runs out the text has
+	// changed then, and there is no tape until an edit makes it valid again.
+	bool Edit(size_t offset, size_t removedLength, const char* inserted, size_t insertedLength);
+	
+	const char* GetText() const { return text; }
+	size_t GetLength() const { return length; }
+	// the readers need a tape, that is the last Parse or Edit returned true
+	Type GetValueType() const;
+	ObjectReaderT<OffsetT> GetObject() const;
+	ArrayReaderT<OffsetT> GetArray() const;
+	const OffsetT* GetTape() const { return valid ? tape.GetMemory() : 0; }
+	// bytes the last Parse or Edit parsed
+	size_t GetParsedLength() const { return parsedLength; }
+	
+	const char* ErrorMessage;
+	size_t ErrorOffset;		// source position ErrorMessage refers to
+	
+private:
+	IncrementalParserT(const IncrementalParserT&);
+	IncrementalParserT& operator=(const IncrementalParserT&);
+	
+	// the members an edit touches in one of the containers around it
+	struct Level
+	{
+		size_t entry;		// tape offset of the container
+		size_t begin;		// its bytes in the text before the edit
+		size_t end;
+		size_t first;		// tape offsets of the members touched
+		size_t last;
+		size_t memberCount;
+		size_t regionBegin;	// their bytes in the text before the edit
+		size_t regionEnd;
+		bool all;			// every member of the container
+	};
+	
+	bool parseAll();
+	size_t findLevels(size_t offset, size_t removedLength, Level* levels) const;
+	bool splice(const Level* levels, size_t depth, size_t removedLength, size_t insertedLength);
+	
+	char* text;
+	size_t length;
+	size_t capacity;
+	char* region;		// members parsed again, in brackets
+	size_t regionCapacity;
+	TapeArenaT<OffsetT> tape;
+	TapeArenaT<OffsetT> work;
+	bool valid;
+	size_t parsedLength;
+};
+
+typedef IncrementalParserT<uint16_t> IncrementalParser;
+typedef IncrementalParserT<uint32_t> IncrementalParser32;
+
+} // namespace json16
+
@@ -0,0 +1,741 @@
+#include "json16_indexer.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define JSON16_X86
+#include <emmintrin.h>
+#if defined(__GNUC__) || (defined(_MSC_VER) && _MSC_VER >= 1700)
+#define JSON16_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__)
+#define JSON16_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define JSON16_TARGET_AVX2
+#endif
+
+namespace json16 {
+
+static inline
+unsigned countTrailingZeros(uint64_t v)
+{
+#if defined(_MSC_VER)
+	unsigned long idx;
+#if defined(_M_X64)
+	_BitScanForward64(&idx, v);
+	return idx;
+#else
+	if (_BitScanForward(&idx, (uint32_t)v)) {
+		return idx;
+	}
+	_BitScanForward(&idx, (uint32_t)(v >> 32));
+	return idx + 32;
+#endif
+#else
+	return __builtin_ctzll(v);
+#endif
+}
+
+// bit i of the result is the xor of bits 0..i
+static inline
+uint64_t prefixXor(uint64_t v)
+{
+	v ^= v << 1;
+	v ^= v << 2;
+	v ^= v << 4;
+	v ^= v << 8;
+	v ^= v << 16;
+	v ^= v << 32;
+	return v;
+}
+
+// returns the characters escaped by an odd-length run of backslashes
+static inline
+uint64_t findEscaped(uint64_t backslash, uint64_t& prevEscaped)
+{
+	const uint64_t evenBits = 0x5555555555555555ULL;
+	backslash &= ~prevEscaped;
+	uint64_t followsEscape = (backslash << 1) | prevEscaped;
+	uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+	uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+	prevEscaped = (sequencesStartingOnEvenBits < oddSequenceStarts) ? 1 : 0;
+	uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+	return (evenBits ^ invertMask) & followsEscape;
+}
+
+static
+void classifyBlockScalar(const char* block, BlockMasks& masks)
+{
+	memset(&masks, 0, sizeof(masks));
+	for (size_t i=0; i<StructuralIndexer::BlockSize; ++i) {
+		unsigned char c = block[i];
+		uint64_t bit = (uint64_t)1 << i;
+		switch (c) {
+		case '"':
+			masks.quote |= bit;
+			break;
+		case '\\':
+			masks.backslash |= bit;
+			break;
+		case '{': case '}': case '[': case ']': case ':': case ',':
+			masks.op |= bit;
+			break;
+		case ' ': case '\t': case '\n': case '\v': case '\f': case '\r':
+			masks.space |= bit;
+			break;
+		}
+		if (c < 0x20) {
+			masks.control |= bit;
+		}
+		if (c >= 0x80) {
+			masks.high |= bit;
+		}
+	}
+}
+
+static
+bool checkUtf8BlockScalar(const char* block, const char* prev, bool& incomplete)
+{
+	const unsigned char* b = (const unsigned char*)block;
+	const unsigned char* before = (const unsigned char*)prev + 32;
+	ptrdiff_t i = 0;
+	if (incomplete) {
+		// go back to the lead byte of the sequence left open by the last block
+		do {
+			--i;
+		}while ((before[i] & 0xC0) == 0x80);
+	}
+	incomplete = false;
+	const ptrdiff_t size = StructuralIndexer::BlockSize;
+	while (i < size) {
+		unsigned char c = (i < 0) ? before[i] : b[i];
+		if (c < 0x80) {
+			++i;
+			continue;
+		}
+		unsigned char low, high;
+		ptrdiff_t n = (ptrdiff_t)utf8SequenceLength(c, low, high);
+		if (n == 0) {
+			return false;
+		}
+		for (ptrdiff_t k=1; k<n; ++k) {
+			if (i + k == size) {
+				incomplete = true;
+				return true;
+			}
+			unsigned char t = (i + k < 0) ? before[i + k] : b[i + k];
+			if (t < low || t > high) {
+				return false;
+			}
+			low = 0x80;
+			high = 0xBF;
+		}
+		i += n;
+	}
+	return true;
+}
+
+#ifdef JSON16_X86
+
+static
+void classifyBlockSSE2(const char* block, BlockMasks& masks)
+{
+	memset(&masks, 0, sizeof(masks));
+	for (size_t i=0; i<4; ++i) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(block + i*16));
+		__m128i op = _mm_or_si128(
+			_mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('{')), _mm_cmpeq_epi8(v, _mm_set1_epi8('}'))),
+				_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('[')), _mm_cmpeq_epi8(v, _mm_set1_epi8(']')))
+			),
+			_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(',')))
+		);
+		// \t \n \v \f \r are 9..13
+		__m128i space = _mm_or_si128(
+			_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+			_mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(8)), _mm_cmplt_epi8(v, _mm_set1_epi8(14)))
+		);
+		__m128i control = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1F)), v);	// unsigned v <= 0x1F
+		size_t shift = i * 16;
+		masks.quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('"'))) << shift;
+		masks.backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))) << shift;
+		masks.op |= (uint64_t)(uint16_t)_mm_movemask_epi8(op) << shift;
+		masks.space |= (uint64_t)(uint16_t)_mm_movemask_epi8(space) << shift;
+		masks.control |= (uint64_t)(uint16_t)_mm_movemask_epi8(control) << shift;
+		masks.high |= (uint64_t)(uint16_t)_mm_movemask_epi8(v) << shift;
+	}
+}
+
+#endif // #ifdef JSON16_X86
+
+#ifdef JSON16_AVX2
+
+static JSON16_TARGET_AVX2
+void classifyBlockAVX2(const char* block, BlockMasks& masks)
+{
+	memset(&masks, 0, sizeof(masks));
+	for (size_t i=0; i<2; ++i) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(block + i*32));
+		__m256i op = _mm256_or_si256(
+			_mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('}'))),
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('[')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(']')))
+			),
+			_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(',')))
+		);
+		__m256i space = _mm256_or_si256(
+			_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+			_mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(8)), _mm256_cmpgt_epi8(_mm256_set1_epi8(14), v))
+		);
+		__m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(0x1F)), v);
+		size_t shift = i * 32;
+		masks.quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'))) << shift;
+		masks.backslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))) << shift;
+		masks.op |= (uint64_t)(uint32_t)_mm256_movemask_epi8(op) << shift;
+		masks.space |= (uint64_t)(uint32_t)_mm256_movemask_epi8(space) << shift;
+		masks.control |= (uint64_t)(uint32_t)_mm256_movemask_epi8(control) << shift;
+		masks.high |= (uint64_t)(uint32_t)_mm256_movemask_epi8(v) << shift;
+	}
+}
+
+// UTF-8 check after Keiser and Lemire, "Validating UTF-8 In Less Than One
+// Instruction Per Byte". Each byte is looked up together with the byte in
+// front of it by their nibbles; an error bit survives the three lookups only
+// for a pair that cannot occur in well-formed text.
+enum {
+	Utf8_TooShort = 1 << 0,		// lead or ASCII followed by lead or ASCII
+	Utf8_TooLong = 1 << 1,		// ASCII followed by continuation
+	Utf8_Overlong3 = 1 << 2,	// E0 80..9F
+	Utf8_TooLarge = 1 << 3,		// F4 90..BF, F5..FF
+	Utf8_Surrogate = 1 << 4,	// ED A0..BF
+	Utf8_Overlong2 = 1 << 5,	// C0..C1
+	Utf8_TooLarge1000 = 1 << 6,	// F5..FF 80..8F
+	Utf8_Overlong4 = 1 << 6,	// F0 80..8F
+	Utf8_TwoConts = 1 << 7,		// continuation followed by continuation
+	Utf8_Carry = Utf8_TooShort | Utf8_TooLong | Utf8_TwoConts,
+};
+
+static const uint8_t utf8Byte1High[16] = {
+	// 0_______ ASCII
+	Utf8_TooLong, Utf8_TooLong, Utf8_TooLong, Utf8_TooLong,
+	Utf8_TooLong, Utf8_TooLong, Utf8_TooLong, Utf8_TooLong,
+	// 10______ continuation
+	Utf8_TwoConts, Utf8_TwoConts, Utf8_TwoConts, Utf8_TwoConts,
+	// 1100____ 1101____ two byte lead
+	Utf8_TooShort | Utf8_Overlong2,
+	Utf8_TooShort,
+	// 1110____ three byte lead
+	Utf8_TooShort | Utf8_Overlong3 | Utf8_Surrogate,
+	// 1111____ four byte lead
+	Utf8_TooShort | Utf8_TooLarge | Utf8_TooLarge1000 | Utf8_Overlong4,
+};
+
+static const uint8_t utf8Byte1Low[16] = {
+	Utf8_Carry | Utf8_Overlong3 | Utf8_Overlong2 | Utf8_Overlong4,	// ____0000
+	Utf8_Carry | Utf8_Overlong2,	// ____0001
+	Utf8_Carry,
+	Utf8_Carry,
+	Utf8_Carry | Utf8_TooLarge,	// ____0100
+	Utf8_Carry | Utf8_TooLarge | Utf8_TooLarge1000,
+	Utf8_Carry | Utf8_TooLarge | Utf8_TooLarge1000,
+	Utf8_Carry | Utf8_TooLarge | Utf8_TooLarge1000,
+	Utf8_Carry | Utf8_TooLarge | Utf8_TooLarge1000,
+	Utf8_Carry | Utf8_TooLarge | Utf8_TooLarge1000,
+	Utf8_Carry | Utf8_TooLarge | Utf8_TooLarge1000,
+	Utf8_Carry | Utf8_TooLarge | Utf8_TooLarge1000,
+	Utf8_Carry | Utf8_TooLarge | Utf8_TooLarge1000,
+	Utf8_Carry | Utf8_TooLarge | Utf8_TooLarge1000 | Utf8_Surrogate,	// ____1101
+	Utf8_Carry | Utf8_TooLarge | Utf8_TooLarge1000,
+	Utf8_Carry | Utf8_TooLarge | Utf8_TooLarge1000,
+};
+
+static const uint8_t utf8Byte2High[16] = {
+	// ________ 0_______ ASCII
+	Utf8_TooShort, Utf8_TooShort, Utf8_TooShort, Utf8_TooShort,
+	Utf8_TooShort, Utf8_TooShort, Utf8_TooShort, Utf8_TooShort,
+	// ________ 1000____
+	Utf8_TooLong | Utf8_Overlong2 | Utf8_TwoConts | Utf8_Overlong3 | Utf8_TooLarge1000 | Utf8_Overlong4,
+	// ________ 1001____
+	Utf8_TooLong | Utf8_Overlong2 | Utf8_TwoConts | Utf8_Overlong3 | Utf8_TooLarge,
+	// ________ 101_____
+	Utf8_TooLong | Utf8_Overlong2 | Utf8_TwoConts | Utf8_Surrogate | Utf8_TooLarge,
+	Utf8_TooLong | Utf8_Overlong2 | Utf8_TwoConts | Utf8_Surrogate | Utf8_TooLarge,
+	// ________ 11______ lead
+	Utf8_TooShort, Utf8_TooShort, Utf8_TooShort, Utf8_TooShort,
+};
+
+static inline JSON16_TARGET_AVX2
+__m256i lookupNibble(const uint8_t* table, __m256i nibbles)
+{
+	__m256i t = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)table));
+	return _mm256_shuffle_epi8(t, nibbles);
+}
+
+// non-zero bytes mark errors in input, prevInput holds the 32 bytes in front of it
+static inline JSON16_TARGET_AVX2
+__m256i checkUtf8Vector(__m256i input, __m256i prevInput)
+{
+	__m256i joined = _mm256_permute2x128_si256(prevInput, input, 0x21);
+	__m256i prev1 = _mm256_alignr_epi8(input, joined, 15);
+	__m256i prev2 = _mm256_alignr_epi8(input, joined, 14);
+	__m256i prev3 = _mm256_alignr_epi8(input, joined, 13);
+	
+	__m256i lowNibble = _mm256_set1_epi8(0x0F);
+	__m256i special = _mm256_and_si256(
+		_mm256_and_si256(
+			lookupNibble(utf8Byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lowNibble)),
+			lookupNibble(utf8Byte1Low, _mm256_and_si256(prev1, lowNibble))
+		),
+		lookupNibble(utf8Byte2High, _mm256_and_si256(_mm256_srli_epi16(input, 4), lowNibble))
+	);
+	// the third and fourth bytes of a sequence must be continuations,
+	// which is the only case where TwoConts is not an error
+	__m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+	__m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+	__m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+	return _mm256_xor_si256(must23, special);
+}
+
+static JSON16_TARGET_AVX2
+bool checkUtf8BlockAVX2(const char* block, const char* prev, bool& incomplete)
+{
+	__m256i prevInput = _mm256_loadu_si256((const __m256i*)prev);
+	__m256i input0 = _mm256_loadu_si256((const __m256i*)block);
+	__m256i input1 = _mm256_loadu_si256((const __m256i*)(block + 32));
+	__m256i error = _mm256_or_si256(
+		checkUtf8Vector(input0, prevInput),
+		checkUtf8Vector(input1, input0)
+	);
+	// a lead byte in the last three positions that needs more bytes than are left
+	__m256i maxValue = _mm256_setr_epi8(
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		(char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1)
+	);
+	__m256i open = _mm256_subs_epu8(input1, maxValue);
+	incomplete = !_mm256_testz_si256(open, open);
+	return _mm256_testz_si256(error, error) != 0;
+}
+
+#endif // #ifdef JSON16_AVX2
+
+#ifdef JSON16_X86
+
+static
+void cpuid(int info[4], int leaf)
+{
+#if defined(_MSC_VER)
+	__cpuidex(info, leaf, 0);
+#else
+	__asm__ __volatile__ (
+		"cpuid"
+		: "=a"(info[0]), "=b"(info[1]), "=c"(info[2]), "=d"(info[3])
+		: "a"(leaf), "c"(0)
+	);
+#endif
+}
+
+static
+bool cpuHasSSE2()
+{
+	int info[4];
+	cpuid(info, 1);
+	return (info[3] & (1 << 26)) != 0;
+}
+
+static
+bool cpuHasAVX2()
+{
+	int info[4];
+	cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+	cpuid(info, 1);
+	const int osxsave = 1 << 27;
+	const int avx = 1 << 28;
+	if ((info[2] & (osxsave|avx)) != (osxsave|avx)) {
+		return false;
+	}
+	// the OS has to save the ymm registers
+	uint32_t xcr0;
+#if defined(_MSC_VER)
+	xcr0 = (uint32_t)_xgetbv(0);
+#else
+	__asm__ __volatile__ ("xgetbv" : "=a"(xcr0) : "c"(0) : "edx");
+#endif
+	if ((xcr0 & 6) != 6) {
+		return false;
+	}
+	cpuid(info, 7);
+	return (info[1] & (1 << 5)) != 0;
+}
+
+#endif // #ifdef JSON16_X86
+
+static
+ClassifyBlockFunc selectClassifyBlock()
+{
+#ifdef JSON16_AVX2
+	if (cpuHasAVX2()) {
+		return classifyBlockAVX2;
+	}
+#endif
+#ifdef JSON16_X86
+	if (cpuHasSSE2()) {
+		return classifyBlockSSE2;
+	}
+#endif
+	return classifyBlockScalar;
+}
+
+ClassifyBlockFunc GetClassifyBlock()
+{
+	static ClassifyBlockFunc func = selectClassifyBlock();
+	return func;
+}
+
+// SSE2 has no byte shuffle for the lookups, so below AVX2 the blocks that
+// are not pure ASCII are checked one sequence at a time
+static
+CheckUtf8BlockFunc selectCheckUtf8Block()
+{
+#ifdef JSON16_AVX2
+	if (cpuHasAVX2()) {
+		return checkUtf8BlockAVX2;
+	}
+#endif
+	return checkUtf8BlockScalar;
+}
+
+CheckUtf8BlockFunc GetCheckUtf8Block()
+{
+	static CheckUtf8BlockFunc func = selectCheckUtf8Block();
+	return func;
+}
+
+// position of the first byte that breaks UTF-8 at or after the sequence
+// running over pos, which is where a block check failed
+static
+size_t findUtf8Error(const char* json, size_t len, size_t pos)
+{
+	const unsigned char* s = (const unsigned char*)json;
+	size_t i = (pos > 3) ? pos - 3 : 0;
+	// text in front of pos is well-formed, skip to a sequence boundary
+	while (i < pos && (s[i] & 0xC0) == 0x80) {
+		++i;
+	}
+	while (i < len) {
+		unsigned char low, high;
+		size_t n = utf8SequenceLength(s[i], low, high);
+		if (n == 0) {
+			return i;
+		}
+		for (size_t k=1; k<n; ++k) {
+			if (i + k == len || s[i + k] < low || s[i + k] > high) {
+				return i;
+			}
+			low = 0x80;
+			high = 0xBF;
+		}
+		i += n;
+	}
+	return len;
+}
+
+StructuralIndexer::StructuralIndexer(const char* json, size_t len)
+	:
+	ErrorMessage(0),
+	ErrorOffset(0),
+	json(json),
+	len(len),
+	end(len),
+	blockPos(0),
+	prevEscaped(0),
+	prevInString(0),
+	prevScalar(0),
+	utf8Incomplete(false),
+	startsInString(false),
+	validateUtf8(true)
+{
+}
+
+static inline
+bool isOddBackslashRun(const char* json, size_t pos)
+{
+	size_t run = 0;
+	while (run < pos && json[pos - 1 - run] == '\\') {
+		++run;
+	}
+	return (run & 1) != 0;
+}
+
+void StructuralIndexer::Restrict(size_t begin, size_t end, bool inString)
+{
+	blockPos = begin;
+	this->end = end;
+	startsInString = inString;
+	prevInString = inString ? ~(uint64_t)0 : 0;
+	prevEscaped = isOddBackslashRun(json, begin) ? 1 : 0;
+	prevScalar = 0;
+	utf8Incomplete = false;
+	if (begin == 0) {
+		return;
+	}
+	switch (json[begin - 1]) {
+	case '{': case '}': case '[': case ']': case ':': case ',':
+	case ' ': case '\t': case '\n': case '\v': case '\f': case '\r':
+		break;
+	case '"':
+		prevScalar = isOddBackslashRun(json, begin - 1) ? 1 : 0;
+		break;
+	default:
+		prevScalar = 1;
+		break;
+	}
+	// a sequence that starts in front of begin and is not complete there
+	const unsigned char* s = (const unsigned char*)json;
+	for (size_t k=1; k<=3 && k<=begin; ++k) {
+		unsigned char c = s[begin - k];
+		if ((c & 0xC0) == 0x80) {
+			continue;
+		}
+		unsigned char low, high;
+		utf8Incomplete = (utf8SequenceLength(c, low, high) > k);
+		break;
+	}
+}
+
+static inline
+size_t popCount(uint64_t v)
+{
+	v = v - ((v >> 1) & 0x5555555555555555ULL);
+	v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+	v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (size_t)((v * 0x0101010101010101ULL) >> 56);
+}
+
+size_t StructuralIndexer::CountQuotes()
+{
+	ClassifyBlockFunc classify = GetClassifyBlock();
+	size_t count = 0;
+	while (blockPos < end) {
+		const char* block = json + blockPos;
+		char tail[BlockSize];
+		size_t remain = len - blockPos;
+		if (remain < BlockSize) {
+			memset(tail, ' ', BlockSize);
+			memcpy(tail, block, remain);
+			block = tail;
+		}
+		BlockMasks masks;
+		classify(block, masks);
+		uint64_t escaped = findEscaped(masks.backslash, prevEscaped);
+		count += popCount(masks.quote & ~escaped);
+		blockPos += BlockSize;
+	}
+	return count;
+}
+
+size_t StructuralIndexer::Next(uint32_t* positions)
+{
+	ClassifyBlockFunc classify = GetClassifyBlock();
+	CheckUtf8BlockFunc checkUtf8 = GetCheckUtf8Block();
+	static const char noPrev[32] = {0};
+	while (blockPos < end) {
+		const char* block = json + blockPos;
+		char tail[BlockSize];
+		size_t remain = len - blockPos;
+		if (remain < BlockSize) {
+			// pad with spaces so nothing past the end is read or reported
+			memset(tail, ' ', BlockSize);
+			memcpy(tail, block, remain);
+			block = tail;
+		}
+		BlockMasks masks;
+		classify(block, masks);
+		
+		uint64_t escaped = findEscaped(masks.backslash, prevEscaped);
+		uint64_t quote = masks.quote & ~escaped;
+		uint64_t inString = prefixXor(quote) ^ prevInString;
+		prevInString = (uint64_t)((int64_t)inString >> 63);
+		
+		uint64_t scalar = ~(masks.op | masks.space | quote);
+		uint64_t scalarStart = scalar & ~((scalar << 1) | prevScalar);
+		prevScalar = scalar >> 63;
+		
+		uint64_t invalid = masks.control & inString & ~quote;
+		if (invalid) {
+			ErrorMessage = "invalid character in string";
+			ErrorOffset = blockPos + countTrailingZeros(invalid);
+			return 0;
+		}
+		if (validateUtf8 && (masks.high || utf8Incomplete)) {
+			const char* prev = blockPos ? json + blockPos - 32 : noPrev;
+			if (!checkUtf8(block, prev, utf8Incomplete)) {
+				ErrorMessage = "invalid UTF-8";
+				ErrorOffset = findUtf8Error(json, len, blockPos);
+				return 0;
+			}
+		}
+		
+		uint64_t structurals = ((masks.op | scalarStart) & ~inString) | quote;
+		size_t base = blockPos;
+		blockPos += BlockSize;
+		size_t n = 0;
+		while (structurals) {
+			positions[n++] = (uint32_t)(base + countTrailingZeros(structurals));
+			structurals &= structurals - 1;
+		}
+		if (n) {
+			return n;
+		}
+	}
+	// a range that stops short of len leaves the rest to the next range
+	if (end != len) {
+		return 0;
+	}
+	if (utf8Incomplete) {
+		// only reachable when the input ends on a block boundary,
+		// a shorter last block is padded with spaces
+		ErrorMessage = "invalid UTF-8";
+		ErrorOffset = findUtf8Error(json, len, len);
+	}else if (prevInString) {
+		ErrorMessage = "unterminated string";
+		ErrorOffset = len;
+	}
+	return 0;
+}
+static
+uint64_t matchLineFeedScalar(const char* block)
+{
+	uint64_t mask = 0;
+	for (size_t i=0; i<StructuralIndexer::BlockSize; ++i) {
+		mask |= (uint64_t)(block[i] == '\n') << i;
+	}
+	return mask;
+}
+
+#ifdef JSON16_X86
+
+static
+uint64_t matchLineFeedSSE2(const char* block)
+{
+	__m128i lf = _mm_set1_epi8('\n');
+	uint64_t mask = 0;
+	for (size_t i=0; i<4; ++i) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(block + i*16));
+		mask |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, lf)) << (i * 16);
+	}
+	return mask;
+}
+
+#endif // #ifdef JSON16_X86
+
+#ifdef JSON16_AVX2
+
+static JSON16_TARGET_AVX2
+uint64_t matchLineFeedAVX2(const char* block)
+{
+	__m256i lf = _mm256_set1_epi8('\n');
+	__m256i v0 = _mm256_loadu_si256((const __m256i*)block);
+	__m256i v1 = _mm256_loadu_si256((const __m256i*)(block + 32));
+	return (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v0, lf))
+		| ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v1, lf)) << 32);
+}
+
+#endif // #ifdef JSON16_AVX2
+
+typedef uint64_t (*MatchLineFeedFunc)(const char* block);
+
+static
+MatchLineFeedFunc selectMatchLineFeed()
+{
+#ifdef JSON16_AVX2
+	if (cpuHasAVX2()) {
+		return matchLineFeedAVX2;
+	}
+#endif
+#ifdef JSON16_X86
+	if (cpuHasSSE2()) {
+		return matchLineFeedSSE2;
+	}
+#endif
+	return matchLineFeedScalar;
+}
+
+LineSplitter::LineSplitter(const char* text, size_t len)
+	:
+	text(text),
+	len(len),
+	blockPos(0),
+	mask(0)
+{
+}
+
+size_t LineSplitter::Next()
+{
+	static MatchLineFeedFunc match = selectMatchLineFeed();
+	while (!mask) {
+		if (blockPos >= len) {
+			return len;
+		}
+		const char* block = text + blockPos;
+		char tail[StructuralIndexer::BlockSize];
+		size_t remain = len - blockPos;
+		if (remain < StructuralIndexer::BlockSize) {
+			memset(tail, 0, StructuralIndexer::BlockSize);
+			memcpy(tail, block, remain);
+			block = tail;
+		}
+		mask = match(block);
+		blockPos += StructuralIndexer::BlockSize;
+	}
+	size_t pos = blockPos - StructuralIndexer::BlockSize + countTrailingZeros(mask);
+	mask &= mask - 1;
+	return pos;
+}
+
+// The indexer already drops brackets inside strings, so counting is enough.
+size_t FindContainerEnd(const char* json, size_t len, size_t pos, const char*& errorMessage)
+{
+	StructuralIndexer indexer(json + pos, len - pos);
+	uint32_t positions[StructuralIndexer::BlockSize];
+	size_t depth = 0;
+	size_t n;
+	while ((n = indexer.Next(positions)) != 0) {
+		for (size_t i=0; i<n; ++i) {
+			switch (json[pos + positions[i]]) {
+			case '{':
+			case '[':
+				++depth;
+				break;
+			case '}':
+			case ']':
+				if (--depth == 0) {
+					return pos + positions[i] + 1;
+				}
+				break;
+			}
+		}
+	}
+	errorMessage = indexer.ErrorMessage ? indexer.ErrorMessage : "unexpected end of input";
+	return 0;
+}
+
+size_t FindContainerEnd(const char* json, size_t len, size_t pos)
+{
+	const char* errorMessage;
+	return FindContainerEnd(json, len, pos, errorMessage);
+}
+
+} // namespace json16
+
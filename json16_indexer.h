@@ -0,0 +1,129 @@
+#pragma once
+
+namespace json16 {
+
+// First pass over the input text.
+// Finds unescaped quotes, structural characters outside of strings and
+// the first character of each number / true / false / null, 64 bytes at a time.
+// Blocks holding bytes >= 0x80 are checked for well-formed UTF-8 on the way;
+// pure ASCII blocks skip the check.
+// Uses AVX2 or SSE2 when the CPU supports it, scalar code otherwise.
+struct StructuralIndexer
+{
+public:
+	enum { BlockSize = 64 };
+	
+	StructuralIndexer(const char* json, size_t len);
+	
+	// Writes the source positions found in the next block (at most BlockSize)
+	// and returns how many were written. Returns 0 once the input is exhausted.
+	size_t Next(uint32_t* positions);
+	
+	// Limits the indexer to [begin, end) of the input, for chunks parsed in
+	// parallel. begin is a multiple of BlockSize, end one too or len.
+	// The state carried between blocks is recovered from the bytes in front of
+	// begin, except whether begin is inside a string, which the caller gets
+	// from the quotes counted in front of it.
+	void Restrict(size_t begin, size_t end, bool inString);
+	// Number of unescaped quotes from the current position to the end.
+	// Consumes the range like Next does.
+	size_t CountQuotes();
+	
+	bool StartsInString() const { return startsInString; }
+	// for input known to be valid, bytes >= 0x80 are passed as they are
+	void SkipUtf8Check() { validateUtf8 = false; }
+	size_t GetEnd() const { return end; }
+	
+	const char* ErrorMessage;
+	size_t ErrorOffset;
+private:
+	const char* json;
+	size_t len;
+	size_t end;
+	size_t blockPos;
+	uint64_t prevEscaped;
+	uint64_t prevInString;
+	uint64_t prevScalar;
+	bool utf8Incomplete;	// the last checked block ended inside a sequence
+	bool startsInString;
+	bool validateUtf8;
+};
+
+// Finds the line feeds of newline delimited input, a block at a time with
+// the same instruction set the indexer picks.
+struct LineSplitter
+{
+public:
+	LineSplitter(const char* text, size_t len);
+	
+	// Returns the position of the next '\n', len once there is none left.
+	size_t Next();
+	
+private:
+	const char* text;
+	size_t len;
+	size_t blockPos;	// end of the block mask was taken from
+	uint64_t mask;		// line feeds of that block not returned yet
+};
+
+// Position after the bracket that closes the container starting at pos,
+// 0 when it is not closed. Brackets inside strings are not counted.
+size_t FindContainerEnd(const char* json, size_t len, size_t pos);
+// as above, errorMessage tells why when 0 is returned
+size_t FindContainerEnd(const char* json, size_t len, size_t pos, const char*& errorMessage);
+
+struct BlockMasks
+{
+	uint64_t quote;
+	uint64_t backslash;
+	uint64_t op;
+	uint64_t space;
+	uint64_t control;	// bytes not allowed inside strings
+	uint64_t high;		// bytes >= 0x80, parts of UTF-8 sequences
+};
+
+typedef void (*ClassifyBlockFunc)(const char* block, BlockMasks& masks);
+
+// Checks one block for well-formed UTF-8. prev points at the 32 bytes in
+// front of the block. incomplete carries a sequence that runs over the end
+// of a block into the next call; it is set on return.
+typedef bool (*CheckUtf8BlockFunc)(const char* block, const char* prev, bool& incomplete);
+
+// picks the widest implementation available on this CPU
+ClassifyBlockFunc GetClassifyBlock();
+CheckUtf8BlockFunc GetCheckUtf8Block();
+
+// Length of the UTF-8 sequence that starts with c, 0 when c cannot start one.
+// low and high receive the range allowed for the second byte, which rules out
+// overlong forms, surrogates and code points above U+10FFFF.
+static inline
+size_t utf8SequenceLength(unsigned char c, unsigned char& low, unsigned char& high)
+{
+	low = 0x80;
+	high = 0xBF;
+	if (c < 0x80) {
+		return 1;
+	}else if (c < 0xC2) {
+		return 0;
+	}else if (c < 0xE0) {
+		return 2;
+	}else if (c < 0xF0) {
+		if (c == 0xE0) {
+			low = 0xA0;
+		}else if (c == 0xED) {
+			high = 0x9F;
+		}
+		return 3;
+	}else if (c < 0xF5) {
+		if (c == 0xF0) {
+			low = 0x90;
+		}else if (c == 0xF4) {
+			high = 0x8F;
+		}
+		return 4;
+	}
+	return 0;
+}
+
+} // namespace json16
+
@@ -0,0 +1,279 @@
+#include "json16_lazy.h"
+#include "json16_builder.h"
+#include "json16_number.h"
+
+namespace json16 {
+
+// Position after the closing quote of the string that starts at pos, 0 with
+// errorMessage set when the parser would not take the string either.
+static
+size_t findStringEnd(const char* json, size_t len, size_t pos, bool& hasEscapes, const char*& errorMessage)
+{
+	StructuralIndexer indexer(json + pos, len - pos);
+	uint32_t positions[StructuralIndexer::BlockSize];
+	size_t first = 1;	// the opening quote
+	size_t n;
+	while ((n = indexer.Next(positions)) != 0) {
+		// nothing inside the string is structural, the next one is the closing quote
+		if (first < n) {
+			size_t end = pos + positions[first] + 1;
+			if (!validateEscapes(json + pos + 1, json + end - 1, hasEscapes)) {
+				errorMessage = "invalid escape sequence in string";
+				return 0;
+			}
+			return end;
+		}
+		first = 0;
+	}
+	errorMessage = indexer.ErrorMessage ? indexer.ErrorMessage : "unterminated string";
+	return 0;
+}
+
+LazyReader::LazyReader(const char* json, size_t len)
+	:
+	ErrorMessage(0),
+	json(json),
+	len(len),
+	pos(0),
+	valueEnd(0),
+	valueHasEscapes(false),
+	isObject(false),
+	isRoot(true),
+	started(false),
+	finished(false)
+{
+	size_t p = skipSpace(json, len, 0);
+	if (p < len && (json[p] == '{' || json[p] == '[')) {
+		isObject = (json[p] == '{');
+		pos = p + 1;
+	}else {
+		ErrorMessage = "root is not an object or array";
+	}
+}
+
+LazyReader::LazyReader(const char* json, size_t len, size_t pos, bool isObject)
+	:
+	ErrorMessage(0),
+	json(json),
+	len(len),
+	pos(pos),
+	valueEnd(0),
+	valueHasEscapes(false),
+	isObject(isObject),
+	isRoot(false),
+	started(false),
+	finished(false)
+{
+}
+
+bool LazyReader::readMember()
+{
+	size_t p = pos;
+	if (isObject) {
+		if (p >= len || json[p] != '"') {
+			ErrorMessage = "expected member name";
+			return false;
+		}
+		bool hasEscapes;
+		size_t e = findStringEnd(json, len, p, hasEscapes, ErrorMessage);
+		if (!e) {
+			return false;
+		}
+		name.ptr = json + p + 1;
+		name.length = e - p - 2;
+		name.hasEscapes = hasEscapes;
+		p = skipSpace(json, len, e);
+		if (p >= len || json[p] != ':') {
+			ErrorMessage = ": not after object name";
+			return false;
+		}
+		p = skipSpace(json, len, p + 1);
+	}
+	if (p >= len) {
+		ErrorMessage = "unexpected end of input";
+		return false;
+	}
+	pos = p;
+	valueEnd = 0;
+	// containers are checked when they are read, everything else right away
+	if (json[p] == '{' || json[p] == '[') {
+		return true;
+	}
+	return findValueEnd();
+}
+
+bool LazyReader::findValueEnd()
+{
+	if (valueEnd) {
+		return true;
+	}
+	switch (json[pos]) {
+	case '{':
+	case '[':
+		valueEnd = FindContainerEnd(json, len, pos, ErrorMessage);
+		break;
+	case '"':
+		valueEnd = findStringEnd(json, len, pos, valueHasEscapes, ErrorMessage);
+		break;
+	default:
+		// the literal has to be spelled out, not just start like one
+		if (!(scanScalar(json, len, pos, valueEnd) & TOKEN_VALUE)) {
+			ErrorMessage = "invalid token";
+			valueEnd = 0;
+		}
+		break;
+	}
+	return valueEnd != 0;
+}
+
+// ends the container at the closing bracket at p
+bool LazyReader::finish(size_t p)
+{
+	finished = true;
+	if (isRoot && skipSpace(json, len, p + 1) != len) {
+		ErrorMessage = "extra content after root value";
+	}
+	return false;
+}
+
+bool LazyReader::Next()
+{
+	if (finished || ErrorMessage) {
+		return false;
+	}
+	const char close = isObject ? '}' : ']';
+	size_t p;
+	if (!started) {
+		started = true;
+		p = skipSpace(json, len, pos);
+		if (p < len && json[p] == close) {
+			return finish(p);
+		}
+	}else {
+		if (!findValueEnd()) {
+			return false;
+		}
+		p = skipSpace(json, len, valueEnd);
+		if (p < len && json[p] == close) {
+			return finish(p);
+		}
+		if (p >= len || json[p] != ',') {
+			ErrorMessage = ", not after value";
+			return false;
+		}
+		p = skipSpace(json, len, p + 1);
+	}
+	pos = p;
+	return readMember();
+}
+
+bool LazyReader::Find(const char* key, size_t keyLength)
+{
+	while (Next()) {
+		if (nameEquals(name, key, keyLength)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+StringRef LazyReader::GetName() const
+{
+	return name;
+}
+
+// Next has checked the token, its first byte tells the type
+Type LazyReader::GetValueType() const
+{
+	switch (json[pos]) {
+	case '{': return Type_object;
+	case '[': return Type_array;
+	case '"': return Type_string;
+	case 't': return Type_true;
+	case 'f': return Type_false;
+	case 'n': return Type_null;
+	default: return Type_number;
+	}
+}
+
+StringRef LazyReader::ReadString()
+{
+	StringRef s = StringRef();
+	if (!valueEnd || json[pos] != '"') {
+		if (!ErrorMessage) {
+			ErrorMessage = "value is not a string";
+		}
+		return s;
+	}
+	s.ptr = json + pos + 1;
+	s.length = valueEnd - pos - 2;
+	s.hasEscapes = valueHasEscapes;
+	return s;
+}
+
+// the current value is a number, ErrorMessage is set when it is not
+bool LazyReader::isNumber()
+{
+	if (!valueEnd || GetValueType() != Type_number) {
+		if (!ErrorMessage) {
+			ErrorMessage = "value is not a number";
+		}
+		return false;
+	}
+	return true;
+}
+
+double LazyReader::ReadNumber()
+{
+	if (!isNumber()) {
+		return 0;
+	}
+	return ParseDouble(json + pos, valueEnd - pos);
+}
+
+bool LazyReader::ReadInt64(int64_t& value)
+{
+	if (!isNumber()) {
+		return false;
+	}
+	return ParseInt64(json + pos, valueEnd - pos, value);
+}
+
+bool LazyReader::ReadUInt64(uint64_t& value)
+{
+	if (!isNumber()) {
+		return false;
+	}
+	return ParseUInt64(json + pos, valueEnd - pos, value);
+}
+
+LazyReader LazyReader::ReadObject() const
+{
+	LazyReader r(json, len, pos + 1, true);
+	if (json[pos] != '{') {
+		r.ErrorMessage = "value is not an object";
+	}
+	return r;
+}
+
+LazyReader LazyReader::ReadArray() const
+{
+	LazyReader r(json, len, pos + 1, false);
+	if (json[pos] != '[') {
+		r.ErrorMessage = "value is not an array";
+	}
+	return r;
+}
+
+const char* LazyReader::GetValueText(size_t& length)
+{
+	if (!findValueEnd()) {
+		length = 0;
+		return 0;
+	}
+	length = valueEnd - pos;
+	return json + pos;
+}
+
+} // namespace json16
+
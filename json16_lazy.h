@@ -0,0 +1,60 @@
+#pragma once
+
+#include "json16.h"
+
+namespace json16 {
+
+// On-demand reader that works on the source text without a tape.
+// Members are visited forward only. Names, strings, numbers and literals are
+// checked as the parser checks them when Next gets to them. A container that
+// is not read is skipped by matching brackets with the structural indexer, so
+// untouched subtrees cost a quote/bracket scan and are not validated beyond
+// that.
+struct LazyReader
+{
+public:
+	// reader over the root container
+	LazyReader(const char* json, size_t len);
+	
+	// Moves to the next member / element, skipping the current value.
+	// Returns false at the end of the container or when ErrorMessage is set,
+	// which it is at the end of the root when anything but space follows.
+	bool Next();
+	// Next() until the member named key (unescaped) is found, forward only
+	bool Find(const char* key, size_t keyLength);
+	
+	bool IsObject() const { return isObject; }
+	StringRef GetName() const;
+	Type GetValueType() const;
+	StringRef ReadString();
+	double ReadNumber();
+	bool ReadInt64(int64_t& value);
+	bool ReadUInt64(uint64_t& value);
+	LazyReader ReadObject() const;
+	LazyReader ReadArray() const;
+	
+	// source range of the current value, for forwarding it unchanged
+	const char* GetValueText(size_t& length);
+	
+	const char* ErrorMessage;
+private:
+	LazyReader(const char* json, size_t len, size_t pos, bool isObject);
+	bool readMember();
+	bool finish(size_t p);
+	bool findValueEnd();
+	bool isNumber();
+	
+	const char* json;
+	size_t len;
+	size_t pos;			// start of the current value
+	size_t valueEnd;	// 0 until known
+	bool valueHasEscapes;
+	bool isObject;
+	bool isRoot;
+	bool started;
+	bool finished;
+	StringRef name;
+};
+
+} // namespace json16
+
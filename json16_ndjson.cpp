@@ -0,0 +1,228 @@
+#include "json16_ndjson.h"
+#include "json16_indexer.h"
+#include "json16_tape.h"
+#include "json16_thread.h"
+
+#include <stdlib.h>
+
+namespace json16 {
+
+// The records a thread has left, [begin, end) of the record list.
+// The owner takes from the front, other threads steal from the back.
+struct NdjsonQueue
+{
+	Mutex mutex;
+	size_t begin;
+	size_t end;
+};
+
+template <typename OffsetT>
+struct NdjsonWorker
+{
+	NdjsonRecord* records;
+	NdjsonQueue* queues;
+	size_t queueCount;
+	size_t index;
+	TapeArenaT<OffsetT>* arena;
+};
+
+// takes up to NdjsonGrain records from the front of queue
+static
+bool takeRecords(NdjsonQueue& queue, size_t& first, size_t& count)
+{
+	queue.mutex.Lock();
+	count = queue.end - queue.begin;
+	if (count > NdjsonGrain) {
+		count = NdjsonGrain;
+	}
+	first = queue.begin;
+	queue.begin += count;
+	queue.mutex.Unlock();
+	return count != 0;
+}
+
+// moves the back half of another queue into the empty queue of worker index
+static
+bool stealRecords(NdjsonQueue* queues, size_t queueCount, size_t index)
+{
+	for (size_t i=1; i<queueCount; ++i) {
+		NdjsonQueue& victim = queues[(index + i) % queueCount];
+		victim.mutex.Lock();
+		size_t left = victim.end - victim.begin;
+		size_t begin = victim.end - (left + 1) / 2;
+		size_t end = victim.end;
+		victim.end = begin;
+		victim.mutex.Unlock();
+		if (begin != end) {
+			NdjsonQueue& own = queues[index];
+			own.mutex.Lock();
+			own.begin = begin;
+			own.end = end;
+			own.mutex.Unlock();
+			return true;
+		}
+	}
+	return false;
+}
+
+template <typename OffsetT>
+static
+void parseRecord(NdjsonRecord& record, TapeArenaT<OffsetT>& arena, size_t worker)
+{
+	record.worker = worker;
+	record.tapeOffset = 0;
+	if (record.length > TapeLimits<OffsetT>::MaxPosition) {
+		record.ErrorMessage = "document too large for tape offset width";
+		return;
+	}
+	size_t bound = TapeSizeBound(record.length);
+	if (!arena.Reserve(bound)) {
+		record.ErrorMessage = "out of memory";
+		return;
+	}
+	record.tapeOffset = arena.GetUsed();
+	OffsetT* work = arena.Allocate(bound);
+	ParserT<OffsetT> parser(record.json, record.length, work);
+	record.ErrorMessage = parser.ErrorMessage;
+	// keep only the words the tape took
+	arena.Trim(parser.ErrorMessage ? bound : bound - entrySize((const OffsetT*)work));
+}
+
+template <typename OffsetT>
+static
+void runWorker(void* p)
+{
+	NdjsonWorker<OffsetT>& worker = *(NdjsonWorker<OffsetT>*) p;
+	NdjsonQueue& own = worker.queues[worker.index];
+	for (;;) {
+		size_t first, count;
+		if (!takeRecords(own, first, count)) {
+			if (!stealRecords(worker.queues, worker.queueCount, worker.index)) {
+				break;
+			}
+			continue;
+		}
+		for (size_t i=0; i<count; ++i) {
+			parseRecord(worker.records[first + i], *worker.arena, worker.index);
+		}
+	}
+}
+
+template <typename OffsetT>
+NdjsonBatchT<OffsetT>::NdjsonBatchT()
+	:
+	ErrorMessage(0),
+	records(0),
+	recordCount(0),
+	recordCapacity(0)
+{
+}
+
+template <typename OffsetT>
+NdjsonBatchT<OffsetT>::~NdjsonBatchT()
+{
+	free(records);
+}
+
+template <typename OffsetT>
+bool NdjsonBatchT<OffsetT>::split(const char* text, size_t len)
+{
+	LineSplitter splitter(text, len);
+	size_t begin = 0;
+	for (size_t line=1; begin<=len; ++line) {
+		size_t end = splitter.Next();
+		size_t length = end - begin;
+		if (length && text[end - 1] == '\r') {
+			--length;
+		}
+		if (length) {
+			if (recordCount == recordCapacity) {
+				size_t capacity = recordCapacity ? recordCapacity * 2 : 1024;
+				NdjsonRecord* p = (NdjsonRecord*) realloc(records, capacity * sizeof(NdjsonRecord));
+				if (!p) {
+					return false;
+				}
+				records = p;
+				recordCapacity = capacity;
+			}
+			NdjsonRecord& record = records[recordCount++];
+			record.json = text + begin;
+			record.length = length;
+			record.line = line;
+			record.ErrorMessage = 0;
+		}
+		begin = end + 1;
+	}
+	return true;
+}
+
+template <typename OffsetT>
+bool NdjsonBatchT<OffsetT>::Parse(const char* text, size_t len, size_t threadCount)
+{
+	ErrorMessage = 0;
+	recordCount = 0;
+	for (size_t i=0; i<NdjsonMaxThreads; ++i) {
+		arenas[i].Reset();
+	}
+	if (!split(text, len)) {
+		recordCount = 0;
+		ErrorMessage = "out of memory";
+		return false;
+	}
+
+	if (threadCount == 0) {
+		threadCount = GetProcessorCount();
+	}
+	// no thread without a grain of its own to start with
+	size_t grains = (recordCount + NdjsonGrain - 1) / NdjsonGrain;
+	if (threadCount > grains) {
+		threadCount = grains;
+	}
+	if (threadCount > NdjsonMaxThreads) {
+		threadCount = NdjsonMaxThreads;
+	}
+	if (threadCount == 0) {
+		return true;
+	}
+
+	NdjsonQueue queues[NdjsonMaxThreads];
+	NdjsonWorker<OffsetT> workers[NdjsonMaxThreads];
+	for (size_t i=0; i<threadCount; ++i) {
+		queues[i].begin = recordCount * i / threadCount;
+		queues[i].end = recordCount * (i + 1) / threadCount;
+		NdjsonWorker<OffsetT>& worker = workers[i];
+		worker.records = records;
+		worker.queues = queues;
+		worker.queueCount = threadCount;
+		worker.index = i;
+		worker.arena = &arenas[i];
+	}
+	// a thread that fails to start leaves its records to be stolen
+	Thread threads[NdjsonMaxThreads];
+	for (size_t i=1; i<threadCount; ++i) {
+		threads[i].Start(runWorker<OffsetT>, &workers[i]);
+	}
+	runWorker<OffsetT>(&workers[0]);
+	for (size_t i=1; i<threadCount; ++i) {
+		threads[i].Join();
+	}
+	return true;
+}
+
+template <typename OffsetT>
+ParserT<OffsetT> NdjsonBatchT<OffsetT>::GetParser(size_t i) const
+{
+	const NdjsonRecord& record = records[i];
+	if (record.ErrorMessage) {
+		ParserT<OffsetT> parser(record.json, (const OffsetT*)0);
+		parser.ErrorMessage = record.ErrorMessage;
+		return parser;
+	}
+	return ParserT<OffsetT>(record.json, arenas[record.worker].GetMemory() + record.tapeOffset);
+}
+
+template struct NdjsonBatchT<uint16_t>;
+template struct NdjsonBatchT<uint32_t>;
+
+} // namespace json16
+
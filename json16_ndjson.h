@@ -0,0 +1,88 @@
+#pragma once
+
+#include "json16.h"
+#include "json16_context.h"
+
+namespace json16 {
+
+enum {
+	NdjsonMaxThreads = 64,
+	NdjsonGrain = 16,		// records a thread takes from its queue at a time
+};
+
+// One line of the input. Empty lines are skipped and a '\r' in front of the
+// '\n' is not part of the record.
+struct NdjsonRecord
+{
+	const char* json;
+	size_t length;
+	size_t line;				// 1 based line number in the input
+	const char* ErrorMessage;	// 0 when the record parsed
+	size_t worker;				// the thread whose arena holds the tape
+	size_t tapeOffset;			// in that arena
+};
+
+// Parses newline delimited JSON, one document per line, on several threads.
+// The line feeds are found a block at a time, then every thread takes records
+// from its own share of the lines and writes their tapes into its own arena;
+// a thread that runs out takes half of what another one has left.
+// The results come back in input order and stay valid until the next Parse.
+template <typename OffsetT>
+struct NdjsonBatchT
+{
+public:
+	NdjsonBatchT();
+	~NdjsonBatchT();
+	
+	// 0 threads picks one per processor. Returns false when memory for the
+	// record list runs out; a record that does not parse only sets its own
+	// ErrorMessage.
+	bool Parse(const char* text, size_t len, size_t threadCount = 0);
+	
+	size_t GetRecordCount() const { return recordCount; }
+	const NdjsonRecord& GetRecord(size_t i) const { return records[i]; }
+	// the parsed record, its ErrorMessage when it did not parse
+	ParserT<OffsetT> GetParser(size_t i) const;
+	
+	const char* ErrorMessage;
+private:
+	NdjsonBatchT(const NdjsonBatchT&);
+	NdjsonBatchT& operator=(const NdjsonBatchT&);
+	
+	bool split(const char* text, size_t len);
+	
+	NdjsonRecord* records;
+	size_t recordCount;
+	size_t recordCapacity;
+	TapeArenaT<OffsetT> arenas[NdjsonMaxThreads];
+};
+
+// Walks the records of a batch in input order.
+template <typename OffsetT>
+struct NdjsonReaderT
+{
+public:
+	NdjsonReaderT(const NdjsonBatchT<OffsetT>& batch)
+		:
+		batch(batch),
+		current(0)
+	{
+	}
+	
+	bool AtEnd() const { return current == batch.GetRecordCount(); }
+	void MoveNext() { ++current; }
+	const NdjsonRecord& GetRecord() const { return batch.GetRecord(current); }
+	ParserT<OffsetT> GetParser() const { return batch.GetParser(current); }
+	
+private:
+	const NdjsonBatchT<OffsetT>& batch;
+	size_t current;
+};
+
+typedef NdjsonBatchT<uint16_t> NdjsonBatch;
+typedef NdjsonBatchT<uint32_t> NdjsonBatch32;
+typedef NdjsonReaderT<uint16_t> NdjsonReader;
+typedef NdjsonReaderT<uint32_t> NdjsonReader32;
+
+} // namespace json16
+
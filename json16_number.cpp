@@ -0,0 +1,1829 @@
+#include "json16_number.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <locale.h>
+#include <assert.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace json16 {
+
+/*
+
+Decimal to double conversion follows Eisel-Lemire
+( Daniel Lemire, "Number Parsing at a Gigabyte per Second" )
+
+1. up to 19 significant digits are accumulated into a 64 bit integer w
+2. w * 10^q is exact in double arithmetic when w <= 2^53 and |q| <= 22 (Clinger)
+3. otherwise w is multiplied by a 128 bit approximation of 5^q
+4. when digits were dropped, w and w+1 have to round to the same double,
+   remaining hard cases go to strtod
+
+*/
+
+static const int SmallestPowerOfTen = -342;
+static const int LargestPowerOfTen = 308;
+static const int MantissaBits = 52;
+static const int MinimumExponent = -1023;
+static const int InfinitePower = 0x7FF;
+
+// 5^q for q in [-342, 308], normalized and truncated to 128 bits (high, low)
+static const uint64_t powerOfFive128[] = {
+	0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL,
+	0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL,
+	0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL,
+	0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL,
+	0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL,
+	0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL,
+	0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL,
+	0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL,
+	0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL,
+	0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL,
+	0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL,
+	0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL,
+	0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL,
+	0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL,
+	0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL,
+	0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL,
+	0x84a57695fe98746dULL, 0x014bb630f7604b57ULL,
+	0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL,
+	0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL,
+	0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL,
+	0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL,
+	0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL,
+	0xfd00b897478238d0ULL, 0x8920b098955522b4ULL,
+	0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL,
+	0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL,
+	0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL,
+	0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL,
+	0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL,
+	0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL,
+	0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL,
+	0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL,
+	0xeba09271e88d976bULL, 0xf7864a44c633682eULL,
+	0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL,
+	0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL,
+	0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL,
+	0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL,
+	0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL,
+	0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL,
+	0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL,
+	0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL,
+	0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL,
+	0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL,
+	0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL,
+	0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL,
+	0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL,
+	0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL,
+	0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL,
+	0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL,
+	0xa37fce126597973cULL, 0xe50ff107bab528a0ULL,
+	0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL,
+	0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL,
+	0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL,
+	0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL,
+	0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL,
+	0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL,
+	0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL,
+	0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL,
+	0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL,
+	0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL,
+	0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL,
+	0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL,
+	0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL,
+	0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL,
+	0x91376c36d99995beULL, 0x23100809b9c21fa1ULL,
+	0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL,
+	0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL,
+	0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL,
+	0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL,
+	0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL,
+	0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL,
+	0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL,
+	0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL,
+	0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL,
+	0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL,
+	0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL,
+	0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL,
+	0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL,
+	0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL,
+	0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL,
+	0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL,
+	0xc987434744ac874eULL, 0xa327ffb266b56220ULL,
+	0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL,
+	0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL,
+	0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL,
+	0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL,
+	0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL,
+	0xc0314325637a1939ULL, 0xfa911155fefb5308ULL,
+	0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL,
+	0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL,
+	0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL,
+	0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL,
+	0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL,
+	0xb749faed14125d36ULL, 0xcef980ec671f667bULL,
+	0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL,
+	0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL,
+	0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL,
+	0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL,
+	0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL,
+	0xaecc49914078536dULL, 0x58fae9f773886e18ULL,
+	0xda7f5bf590966848ULL, 0xaf39a475506a899eULL,
+	0x888f99797a5e012dULL, 0x6d8406c952429603ULL,
+	0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL,
+	0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL,
+	0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL,
+	0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL,
+	0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL,
+	0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL,
+	0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL,
+	0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL,
+	0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL,
+	0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL,
+	0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL,
+	0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL,
+	0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL,
+	0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL,
+	0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL,
+	0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL,
+	0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL,
+	0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL,
+	0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL,
+	0xb913179899f68584ULL, 0x28e2557b59846e3fULL,
+	0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL,
+	0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL,
+	0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL,
+	0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL,
+	0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL,
+	0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL,
+	0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL,
+	0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL,
+	0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL,
+	0xd77485cb25823ac7ULL, 0x7d633293366b828bULL,
+	0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL,
+	0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL,
+	0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL,
+	0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL,
+	0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL,
+	0xcd795be870516656ULL, 0x67902e276c921f8bULL,
+	0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL,
+	0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL,
+	0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL,
+	0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL,
+	0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL,
+	0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL,
+	0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL,
+	0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL,
+	0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL,
+	0xef340a98172aace4ULL, 0x86fb897116c87c34ULL,
+	0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL,
+	0xbae0a846d2195712ULL, 0x8974836059cca109ULL,
+	0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL,
+	0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL,
+	0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL,
+	0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL,
+	0x8e938662882af53eULL, 0x547eb47b7282ee9cULL,
+	0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL,
+	0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL,
+	0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL,
+	0xae0b158b4738705eULL, 0x9624ab50b148d445ULL,
+	0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL,
+	0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL,
+	0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL,
+	0xd47487cc8470652bULL, 0x7647c3200069671fULL,
+	0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL,
+	0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL,
+	0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL,
+	0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL,
+	0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL,
+	0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL,
+	0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL,
+	0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL,
+	0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL,
+	0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL,
+	0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL,
+	0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL,
+	0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL,
+	0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL,
+	0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL,
+	0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL,
+	0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL,
+	0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL,
+	0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL,
+	0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL,
+	0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL,
+	0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL,
+	0x8c974f7383725573ULL, 0x1e414218c73a13fbULL,
+	0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL,
+	0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL,
+	0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL,
+	0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL,
+	0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL,
+	0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL,
+	0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL,
+	0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL,
+	0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL,
+	0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL,
+	0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL,
+	0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL,
+	0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL,
+	0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL,
+	0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL,
+	0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL,
+	0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL,
+	0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL,
+	0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL,
+	0xbe89523386091465ULL, 0xf6bbb397f1135823ULL,
+	0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL,
+	0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL,
+	0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL,
+	0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL,
+	0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL,
+	0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL,
+	0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL,
+	0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL,
+	0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL,
+	0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL,
+	0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL,
+	0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL,
+	0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL,
+	0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL,
+	0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL,
+	0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL,
+	0x843610cb4bf160cbULL, 0xcedf722a585139baULL,
+	0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL,
+	0xce947a3da6a9273eULL, 0x733d226229feea32ULL,
+	0x811ccc668829b887ULL, 0x0806357d5a3f525fULL,
+	0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL,
+	0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL,
+	0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL,
+	0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL,
+	0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL,
+	0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL,
+	0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL,
+	0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL,
+	0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL,
+	0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL,
+	0xbbe226efb628afeaULL, 0x890489f70a55368bULL,
+	0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL,
+	0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL,
+	0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL,
+	0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL,
+	0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL,
+	0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL,
+	0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL,
+	0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL,
+	0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL,
+	0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL,
+	0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL,
+	0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL,
+	0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL,
+	0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL,
+	0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL,
+	0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL,
+	0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL,
+	0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL,
+	0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL,
+	0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL,
+	0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL,
+	0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL,
+	0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL,
+	0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL,
+	0xc24452da229b021bULL, 0xfbe85badce996168ULL,
+	0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL,
+	0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL,
+	0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL,
+	0xed246723473e3813ULL, 0x290123e9aab23b68ULL,
+	0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL,
+	0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL,
+	0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL,
+	0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL,
+	0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL,
+	0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL,
+	0x8d590723948a535fULL, 0x579c487e5a38ad0eULL,
+	0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL,
+	0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL,
+	0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL,
+	0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL,
+	0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL,
+	0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL,
+	0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL,
+	0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL,
+	0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL,
+	0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL,
+	0xcdb02555653131b6ULL, 0x3792f412cb06794dULL,
+	0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL,
+	0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL,
+	0xc8de047564d20a8bULL, 0xf245825a5a445275ULL,
+	0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL,
+	0x9ced737bb6c4183dULL, 0x55464dd69685606bULL,
+	0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL,
+	0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL,
+	0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL,
+	0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL,
+	0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL,
+	0x95a8637627989aadULL, 0xdde7001379a44aa8ULL,
+	0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL,
+	0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL,
+	0x9226712162ab070dULL, 0xcab3961304ca70e8ULL,
+	0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL,
+	0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL,
+	0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL,
+	0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL,
+	0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL,
+	0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL,
+	0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL,
+	0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL,
+	0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL,
+	0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL,
+	0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL,
+	0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL,
+	0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL,
+	0xcfb11ead453994baULL, 0x67de18eda5814af2ULL,
+	0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL,
+	0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL,
+	0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL,
+	0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL,
+	0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL,
+	0xc612062576589ddaULL, 0x95364afe032a819eULL,
+	0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+	0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL,
+	0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,
+	0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL,
+	0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL,
+	0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL,
+	0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+	0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL,
+	0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,
+	0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL,
+	0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL,
+	0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL,
+	0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+	0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL,
+	0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,
+	0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL,
+	0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,
+	0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL,
+	0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+	0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL,
+	0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,
+	0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL,
+	0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL,
+	0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL,
+	0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+	0x8000000000000000ULL, 0x0000000000000000ULL,
+	0xa000000000000000ULL, 0x0000000000000000ULL,
+	0xc800000000000000ULL, 0x0000000000000000ULL,
+	0xfa00000000000000ULL, 0x0000000000000000ULL,
+	0x9c40000000000000ULL, 0x0000000000000000ULL,
+	0xc350000000000000ULL, 0x0000000000000000ULL,
+	0xf424000000000000ULL, 0x0000000000000000ULL,
+	0x9896800000000000ULL, 0x0000000000000000ULL,
+	0xbebc200000000000ULL, 0x0000000000000000ULL,
+	0xee6b280000000000ULL, 0x0000000000000000ULL,
+	0x9502f90000000000ULL, 0x0000000000000000ULL,
+	0xba43b74000000000ULL, 0x0000000000000000ULL,
+	0xe8d4a51000000000ULL, 0x0000000000000000ULL,
+	0x9184e72a00000000ULL, 0x0000000000000000ULL,
+	0xb5e620f480000000ULL, 0x0000000000000000ULL,
+	0xe35fa931a0000000ULL, 0x0000000000000000ULL,
+	0x8e1bc9bf04000000ULL, 0x0000000000000000ULL,
+	0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+	0xde0b6b3a76400000ULL, 0x0000000000000000ULL,
+	0x8ac7230489e80000ULL, 0x0000000000000000ULL,
+	0xad78ebc5ac620000ULL, 0x0000000000000000ULL,
+	0xd8d726b7177a8000ULL, 0x0000000000000000ULL,
+	0x878678326eac9000ULL, 0x0000000000000000ULL,
+	0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+	0xd3c21bcecceda100ULL, 0x0000000000000000ULL,
+	0x84595161401484a0ULL, 0x0000000000000000ULL,
+	0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL,
+	0xcecb8f27f4200f3aULL, 0x0000000000000000ULL,
+	0x813f3978f8940984ULL, 0x4000000000000000ULL,
+	0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+	0xc9f2c9cd04674edeULL, 0xa400000000000000ULL,
+	0xfc6f7c4045812296ULL, 0x4d00000000000000ULL,
+	0x9dc5ada82b70b59dULL, 0xf020000000000000ULL,
+	0xc5371912364ce305ULL, 0x6c28000000000000ULL,
+	0xf684df56c3e01bc6ULL, 0xc732000000000000ULL,
+	0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+	0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL,
+	0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL,
+	0x96769950b50d88f4ULL, 0x1314448000000000ULL,
+	0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL,
+	0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL,
+	0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL,
+	0xb7abc627050305adULL, 0xf14a3d9e40000000ULL,
+	0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL,
+	0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL,
+	0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL,
+	0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL,
+	0x8c213d9da502de45ULL, 0x4526f422cc340000ULL,
+	0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL,
+	0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL,
+	0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL,
+	0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL,
+	0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL,
+	0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL,
+	0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL,
+	0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL,
+	0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL,
+	0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL,
+	0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL,
+	0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL,
+	0x9f4f2726179a2245ULL, 0x01d762422c946590ULL,
+	0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL,
+	0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL,
+	0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL,
+	0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL,
+	0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL,
+	0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL,
+	0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL,
+	0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL,
+	0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL,
+	0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL,
+	0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL,
+	0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL,
+	0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL,
+	0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL,
+	0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL,
+	0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL,
+	0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL,
+	0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL,
+	0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL,
+	0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL,
+	0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL,
+	0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL,
+	0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL,
+	0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL,
+	0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL,
+	0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL,
+	0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL,
+	0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL,
+	0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL,
+	0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL,
+	0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL,
+	0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL,
+	0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL,
+	0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL,
+	0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL,
+	0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL,
+	0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL,
+	0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL,
+	0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL,
+	0x924d692ca61be758ULL, 0x593c2626705f9c56ULL,
+	0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL,
+	0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL,
+	0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL,
+	0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL,
+	0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL,
+	0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL,
+	0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL,
+	0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL,
+	0x884134fe908658b2ULL, 0x3109058d147fdcddULL,
+	0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL,
+	0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL,
+	0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL,
+	0xa6539930bf6bff45ULL, 0x84db8346b786151cULL,
+	0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL,
+	0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL,
+	0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL,
+	0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL,
+	0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL,
+	0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL,
+	0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL,
+	0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL,
+	0x9ae757596946075fULL, 0x3375788de9b06958ULL,
+	0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL,
+	0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL,
+	0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL,
+	0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL,
+	0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL,
+	0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL,
+	0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL,
+	0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL,
+	0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL,
+	0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL,
+	0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL,
+	0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL,
+	0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL,
+	0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL,
+	0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL,
+	0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL,
+	0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL,
+	0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL,
+	0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL,
+	0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL,
+	0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL,
+	0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL,
+	0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL,
+	0x802221226be55a64ULL, 0xc2494954da2c9789ULL,
+	0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL,
+	0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL,
+	0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL,
+	0x9c69a97284b578d7ULL, 0xff2a760414536efbULL,
+	0xc38413cf25e2d70dULL, 0xfef5138519684abaULL,
+	0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL,
+	0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL,
+	0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL,
+	0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL,
+	0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL,
+	0xba756174393d88dfULL, 0x94f971119aeef9e4ULL,
+	0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL,
+	0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL,
+	0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL,
+	0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL,
+	0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL,
+	0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL,
+	0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL,
+	0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL,
+	0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL,
+	0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL,
+	0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL,
+	0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL,
+	0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL,
+	0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL,
+	0xa59bc234db398c25ULL, 0x43fab9837e699095ULL,
+	0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL,
+	0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL,
+	0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL,
+	0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL,
+	0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL,
+	0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL,
+	0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL,
+	0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL,
+	0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL,
+	0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL,
+	0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL,
+	0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL,
+	0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL,
+	0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL,
+	0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL,
+	0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL,
+	0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL,
+	0x8fa475791a569d10ULL, 0xf96e017d694487bcULL,
+	0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL,
+	0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL,
+	0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL,
+	0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL,
+	0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL,
+	0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL,
+	0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL,
+	0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL,
+	0x85c7056562757456ULL, 0xf6872d5667844e49ULL,
+	0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL,
+	0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL,
+	0x82a45b450226b39cULL, 0xecc0024661173473ULL,
+	0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL,
+	0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL,
+	0xff290242c83396ceULL, 0x7e67047175a15271ULL,
+	0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL,
+	0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL,
+	0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL,
+	0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL,
+	0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL,
+	0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL,
+	0x98165af37b2153deULL, 0xc3727a337a8b704aULL,
+	0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL,
+	0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL,
+	0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL,
+	0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL,
+	0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL,
+	0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL,
+	0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL,
+	0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL,
+	0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL,
+	0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL,
+	0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL,
+	0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL,
+	0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL,
+	0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL,
+	0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL,
+	0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL,
+	0xd31045a8341ca07cULL, 0x1ede48111209a050ULL,
+	0x83ea2b892091e44dULL, 0x934aed0aab460432ULL,
+	0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL,
+	0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL,
+	0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL,
+	0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL,
+	0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL,
+	0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL,
+	0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL,
+	0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL,
+	0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL,
+	0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL,
+	0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL,
+	0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL,
+	0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL,
+	0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL,
+	0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL,
+	0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL,
+	0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL,
+	0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL,
+	0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL,
+	0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL,
+	0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL,
+	0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL,
+	0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL,
+	0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL,
+	0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL,
+	0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL,
+	0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL,
+	0x8533285c936b35deULL, 0xd53a88958f87275fULL,
+	0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL,
+	0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL,
+	0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL,
+	0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL,
+	0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL,
+	0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL,
+	0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL,
+	0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL,
+	0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL,
+	0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL,
+	0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL,
+	0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL,
+	0x976e41088617ca01ULL, 0xd5be0503e085d813ULL,
+	0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL,
+	0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL,
+	0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL,
+	0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL,
+	0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL,
+	0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL,
+	0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL,
+	0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL,
+	0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL,
+	0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL,
+	0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL,
+	0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL,
+	0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL,
+	0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL,
+	0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL,
+	0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL,
+	0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL,
+	0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL,
+	0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL,
+	0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL,
+	0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL,
+	0xa0555e361951c366ULL, 0xd7e105bcc332621fULL,
+	0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL,
+	0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL,
+	0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL,
+	0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL,
+	0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL,
+	0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL,
+	0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL,
+	0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL,
+	0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL,
+	0xbaa718e68396cffdULL, 0xd30560258f54e6baULL,
+	0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL,
+	0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL,
+	0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL,
+	0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL,
+	0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL,
+};
+
+static const double powerOfTen[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+struct Value128
+{
+	uint64_t low;
+	uint64_t high;
+};
+
+static inline
+Value128 fullMultiplication(uint64_t a, uint64_t b)
+{
+	Value128 r;
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 p = (unsigned __int128)a * b;
+	r.low = (uint64_t)p;
+	r.high = (uint64_t)(p >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	r.low = _umul128(a, b, &r.high);
+#else
+	uint64_t aLo = (uint32_t)a, aHi = a >> 32;
+	uint64_t bLo = (uint32_t)b, bHi = b >> 32;
+	uint64_t lolo = aLo * bLo;
+	uint64_t hilo = aHi * bLo;
+	uint64_t lohi = aLo * bHi;
+	uint64_t hihi = aHi * bHi;
+	uint64_t cross = (lolo >> 32) + (uint32_t)hilo + lohi;
+	r.high = hihi + (hilo >> 32) + (cross >> 32);
+	r.low = (cross << 32) | (uint32_t)lolo;
+#endif
+	return r;
+}
+
+static inline
+int leadingZeroes(uint64_t v)
+{
+	int n = 0;
+	if (!(v & 0xFFFFFFFF00000000ULL)) { n += 32; v <<= 32; }
+	if (!(v & 0xFFFF000000000000ULL)) { n += 16; v <<= 16; }
+	if (!(v & 0xFF00000000000000ULL)) { n += 8; v <<= 8; }
+	if (!(v & 0xF000000000000000ULL)) { n += 4; v <<= 4; }
+	if (!(v & 0xC000000000000000ULL)) { n += 2; v <<= 2; }
+	if (!(v & 0x8000000000000000ULL)) { n += 1; }
+	return n;
+}
+
+struct AdjustedMantissa
+{
+	uint64_t mantissa;
+	int power2;	// -1 when the product was not precise enough
+	
+	bool operator == (const AdjustedMantissa& o) const
+	{
+		return mantissa == o.mantissa && power2 == o.power2;
+	}
+};
+
+// w * 10^q, w != 0
+static
+AdjustedMantissa computeFloat(int64_t q, uint64_t w)
+{
+	AdjustedMantissa answer;
+	if (q < SmallestPowerOfTen) {
+		answer.power2 = 0;
+		answer.mantissa = 0;
+		return answer;
+	}
+	if (q > LargestPowerOfTen) {
+		answer.power2 = InfinitePower;
+		answer.mantissa = 0;
+		return answer;
+	}
+	int lz = leadingZeroes(w);
+	w <<= lz;
+	
+	size_t index = 2 * (size_t)(q - SmallestPowerOfTen);
+	const uint64_t precisionMask = 0xFFFFFFFFFFFFFFFFULL >> (MantissaBits + 3);
+	Value128 product = fullMultiplication(w, powerOfFive128[index]);
+	if ((product.high & precisionMask) == precisionMask) {
+		Value128 second = fullMultiplication(w, powerOfFive128[index + 1]);
+		product.low += second.high;
+		if (second.high > product.low) {
+			++product.high;
+		}
+	}
+	if (product.low == 0xFFFFFFFFFFFFFFFFULL && (q < -27 || q > 55)) {
+		answer.power2 = -1;
+		answer.mantissa = 0;
+		return answer;
+	}
+	
+	int upperBit = (int)(product.high >> 63);
+	int shift = upperBit + 64 - MantissaBits - 3;
+	answer.mantissa = product.high >> shift;
+	answer.power2 = (int)(((((152170 + 65536) * (int32_t)q) >> 16) + 63) + upperBit - lz - MinimumExponent);
+	if (answer.power2 <= 0) {
+		// subnormal
+		if (-answer.power2 + 1 >= 64) {
+			answer.power2 = 0;
+			answer.mantissa = 0;
+			return answer;
+		}
+		answer.mantissa >>= -answer.power2 + 1;
+		answer.mantissa += (answer.mantissa & 1);
+		answer.mantissa >>= 1;
+		answer.power2 = (answer.mantissa < ((uint64_t)1 << MantissaBits)) ? 0 : 1;
+		return answer;
+	}
+	// exactly halfway between two doubles, round to even
+	if (product.low <= 1 && q >= -4 && q <= 23 && (answer.mantissa & 3) == 1) {
+		if ((answer.mantissa << shift) == product.high) {
+			answer.mantissa &= ~(uint64_t)1;
+		}
+	}
+	answer.mantissa += (answer.mantissa & 1);
+	answer.mantissa >>= 1;
+	if (answer.mantissa >= ((uint64_t)2 << MantissaBits)) {
+		answer.mantissa = (uint64_t)1 << MantissaBits;
+		++answer.power2;
+	}
+	answer.mantissa &= ~((uint64_t)1 << MantissaBits);
+	if (answer.power2 >= InfinitePower) {
+		answer.power2 = InfinitePower;
+		answer.mantissa = 0;
+	}
+	return answer;
+}
+
+static inline
+double toDouble(bool negative, const AdjustedMantissa& am)
+{
+	uint64_t bits = am.mantissa | ((uint64_t)am.power2 << MantissaBits);
+	if (negative) {
+		bits |= (uint64_t)1 << 63;
+	}
+	double d;
+	memcpy(&d, &bits, sizeof(d));
+	return d;
+}
+
+// strtod with '.' swapped for the decimal point of the current locale
+static
+double parseDoubleSlow(const char* p, size_t len)
+{
+	char stackBuff[128];
+	char* buff = (len < sizeof(stackBuff)) ? stackBuff : (char*) malloc(len + 1);
+	memcpy(buff, p, len);
+	buff[len] = 0;
+	char point = localeconv()->decimal_point[0];
+	if (point != '.') {
+		char* dot = (char*) memchr(buff, '.', len);
+		if (dot) {
+			*dot = point;
+		}
+	}
+	char* endptr;
+	double d = strtod(buff, &endptr);
+	if (buff != stackBuff) {
+		free(buff);
+	}
+	return d;
+}
+
+double ParseDouble(const char* p, size_t len)
+{
+	const char* start = p;
+	const char* end = p + len;
+	bool negative = (*p == '-');
+	if (negative) {
+		++p;
+	}
+	uint64_t w = 0;
+	int digits = 0;
+	int64_t exp10 = 0;
+	bool truncated = false;
+	while (p != end && (unsigned)(*p - '0') < 10) {
+		unsigned d = *p++ - '0';
+		if (digits < 19) {
+			if (w || d) {
+				w = w * 10 + d;
+				++digits;
+			}
+		}else {
+			++exp10;
+			truncated |= (d != 0);
+		}
+	}
+	if (p != end && *p == '.') {
+		++p;
+		while (p != end && (unsigned)(*p - '0') < 10) {
+			unsigned d = *p++ - '0';
+			if (digits < 19) {
+				if (w || d) {
+					w = w * 10 + d;
+					++digits;
+				}
+				--exp10;
+			}else {
+				truncated |= (d != 0);
+			}
+		}
+	}
+	if (p != end && (*p == 'e' || *p == 'E')) {
+		++p;
+		bool expNegative = false;
+		if (*p == '-' || *p == '+') {
+			expNegative = (*p == '-');
+			++p;
+		}
+		int64_t e = 0;
+		while (p != end && (unsigned)(*p - '0') < 10) {
+			if (e < 0x10000000) {
+				e = e * 10 + (*p - '0');
+			}
+			++p;
+		}
+		exp10 += expNegative ? -e : e;
+	}
+	if (w == 0) {
+		return negative ? -0.0 : 0.0;
+	}
+	if (!truncated && w <= ((uint64_t)1 << 53) && exp10 >= -22 && exp10 <= 22) {
+		double d = (double) w;
+		if (exp10 < 0) {
+			d /= powerOfTen[-exp10];
+		}else {
+			d *= powerOfTen[exp10];
+		}
+		return negative ? -d : d;
+	}
+	AdjustedMantissa am = computeFloat(exp10, w);
+	if (truncated && am.power2 >= 0) {
+		if (!(computeFloat(exp10, w + 1) == am)) {
+			am.power2 = -1;
+		}
+	}
+	if (am.power2 < 0) {
+		return parseDoubleSlow(start, len);
+	}
+	return toDouble(negative, am);
+}
+
+// digits only, no sign
+static inline
+bool parseDigits(const char* p, const char* end, uint64_t& value)
+{
+	if (p == end) {
+		return false;
+	}
+	uint64_t v = 0;
+	for (; p != end; ++p) {
+		unsigned d = *p - '0';
+		if (d >= 10) {
+			return false;
+		}
+		if (v > (0xFFFFFFFFFFFFFFFFULL - d) / 10) {
+			return false;
+		}
+		v = v * 10 + d;
+	}
+	value = v;
+	return true;
+}
+
+bool ParseInt64(const char* p, size_t len, int64_t& value)
+{
+	bool negative = (len && *p == '-');
+	uint64_t v;
+	if (!parseDigits(p + negative, p + len, v)) {
+		return false;
+	}
+	if (negative) {
+		if (v > (uint64_t)1 << 63) {
+			return false;
+		}
+		value = (int64_t)(0 - v);
+	}else {
+		if (v > 0x7FFFFFFFFFFFFFFFULL) {
+			return false;
+		}
+		value = (int64_t)v;
+	}
+	return true;
+}
+
+bool ParseUInt64(const char* p, size_t len, uint64_t& value)
+{
+	if (len && *p == '-') {
+		// only -0 is representable
+		uint64_t v;
+		if (!parseDigits(p + 1, p + len, v) || v != 0) {
+			return false;
+		}
+		value = 0;
+		return true;
+	}
+	return parseDigits(p, p + len, value);
+}
+
+/*
+
+Double to decimal conversion follows Schubfach
+( Raffaello Giulietti, "The Schubfach way to render doubles" )
+
+1. v = c * 2^q is scaled by a 126 bit approximation of 10^-k,
+   the boundaries of its rounding interval are scaled along with it
+2. the shorter of the two multiples of 10 around the scaled value is taken
+   when exactly one of them lies in the interval
+3. otherwise the closer of s and s+1, ties to even
+
+The result is the shortest decimal that reads back as v.
+
+*/
+
+static const int SmallestCachedPowerOfTen = -292;
+
+// g = floor(10^e / 2^r) + 1, r = floor(log2(10^e)) - 125, for e in [-292, 324] (high, low)
+static const uint64_t powerOfTen126[] = {
+	0x3fddec7f2faf3713ULL, 0xc97a3a2704eec3dfULL,
+	0x27eab3cf7dcd826cULL, 0x5dec645863153a6cULL,
+	0x31e560c35d40e307ULL, 0x75677d6e7bda8906ULL,
+	0x3e5eb8f434911bc9ULL, 0x52c15cca1ad12b48ULL,
+	0x26fb3398a0dab15dULL, 0xd3b8d9fe50c2bb0dULL,
+	0x30ba007ec9115db5ULL, 0x48a7107de4f369d0ULL,
+	0x3ce8809e7b55b522ULL, 0x9ad0d49d5e304444ULL,
+	0x261150630d159135ULL, 0xa0c284e25ade2aabULL,
+	0x2f95a47bd05af583ULL, 0x08f3261af195b555ULL,
+	0x3b7b0d9ac471b2e3ULL, 0xcb2fefa1adfb22abULL,
+	0x252ce880bac70fceULL, 0x5efdf5c50cbcf5abULL,
+	0x2e7822a0e978d3c1ULL, 0xf6bd73364fec3315ULL,
+	0x3a162b4923d708b2ULL, 0x746cd003e3e73fdbULL,
+	0x244ddb0db666656fULL, 0x88c402026e7087e9ULL,
+	0x2d6151d123fffecbULL, 0x6af502830a0ca9e3ULL,
+	0x38b9a6456cfffe7eULL, 0x45b24323cc8fd45cULL,
+	0x237407eb641fff0eULL, 0xeb8f69f65fd9e4b9ULL,
+	0x2c5109e63d27fed2ULL, 0xa6734473f7d05de8ULL,
+	0x37654c5fcc71fe87ULL, 0x50101590f5c47561ULL,
+	0x229f4fbbdfc73f14ULL, 0x920a0d7a999ac95dULL,
+	0x2b4723aad7b90ed9ULL, 0xb68c90d940017bb4ULL,
+	0x3618ec958da75290ULL, 0x242fb50f9001daa1ULL,
+	0x21cf93dd7888939aULL, 0x169dd129ba0128a5ULL,
+	0x2a4378d4d6aab880ULL, 0x9c454574288172ceULL,
+	0x34d4570a0c5566a0ULL, 0xc35696d132a1cf81ULL,
+	0x2104b66647b56024ULL, 0x7a161e42bfa521b1ULL,
+	0x2945e3ffd9a2b82dULL, 0x989ba5d36f8e6a1dULL,
+	0x33975cffd00b6638ULL, 0xfec28f484b7204a4ULL,
+	0x203e9a1fe2071fe3ULL, 0x9f39998d2f2742e7ULL,
+	0x284e40a7da88e7dcULL, 0x8707fff07af113a1ULL,
+	0x3261d0d1d12b21d3ULL, 0xa8c9ffec99ad5889ULL,
+	0x3efa45064575ea48ULL, 0x92fc7fe7c018aeabULL,
+	0x275c6b23eb69b26dULL, 0x5bddcff0d80f6d2bULL,
+	0x313385ece6441f08ULL, 0xb2d543ed0e134875ULL,
+	0x3d8067681fd526caULL, 0xdf8a94e851981a93ULL,
+	0x267040a113e5383eULL, 0xcbb69d1132ff109cULL,
+	0x300c50c958de864eULL, 0x7ea444557fbed4c3ULL,
+	0x3c0f64fbaf1627e2ULL, 0x1e4d556adfae89f3ULL,
+	0x25899f1d4d6dd8edULL, 0x52f05562cbcd1638ULL,
+	0x2eec06e4a0c94f28ULL, 0xa7ac6abb7ec05bc6ULL,
+	0x3aa7089dc8fba2f2ULL, 0xd197856a5e7072b8ULL,
+	0x24a865629d9d45d7ULL, 0xc2feb3627b0647b3ULL,
+	0x2dd27ebb4504974dULL, 0xb3be603b19c7d99fULL,
+	0x39471e6a1645bd21ULL, 0x20adf849e039d007ULL,
+	0x23cc73024deb9634ULL, 0xb46cbb2e2c242205ULL,
+	0x2cbf8fc2e1667bc1ULL, 0xe187e9f9b72d2a86ULL,
+	0x37ef73b399c01ab2ULL, 0x59e9e47824f87527ULL,
+	0x22f5a850401810afULL, 0x78322ecb171b4939ULL,
+	0x2bb31264501e14dbULL, 0x563eba7ddce21b87ULL,
+	0x369fd6fd64259a12ULL, 0x2bce691d541aa268ULL,
+	0x2223e65e5e97804bULL, 0x5b6101b25490a581ULL,
+	0x2aacdff5f63d605eULL, 0x3239421ee9b4cee1ULL,
+	0x355817f373ccb875ULL, 0xbec792a6a422029aULL,
+	0x21570ef8285ff349ULL, 0x973cbba8269541a0ULL,
+	0x29acd2b63277f01bULL, 0xfd0bea92303a9208ULL,
+	0x34180763bf15ec22ULL, 0xfc4ee536bc49368aULL,
+	0x208f049e576db395ULL, 0xddb14f4235adc217ULL,
+	0x28b2c5c5ed49207bULL, 0x551da312c319329cULL,
+	0x32df7737689b689aULL, 0x2a650bd773df7f43ULL,
+	0x3f97550542c242c0ULL, 0xb4fe4ecd50d75f14ULL,
+	0x27be952349b969b8ULL, 0x711ef14052869b6cULL,
+	0x31ae3a6c1c27c426ULL, 0x8d66ad9067284247ULL,
+	0x3e19c9072331b530ULL, 0x30c058f480f252d9ULL,
+	0x26d01da475ff113eULL, 0x1e783798d09773c8ULL,
+	0x3084250d937ed58dULL, 0xa616457f04bd50baULL,
+	0x3ca52e50f85e8af1ULL, 0x0f9bd6dec5eca4e8ULL,
+	0x25e73cf29b3b16d6ULL, 0xa9c1664b3bb3e711ULL,
+	0x2f610c2f4209dc8cULL, 0x5431bfde0aa0e0d5ULL,
+	0x3b394f3b128c53afULL, 0x693e2fd58d49190bULL,
+	0x2503d184eb97b44dULL, 0xa1c6dde5784dafa7ULL,
+	0x2e44c5e6267da161ULL, 0x0a38955ed6611b90ULL,
+	0x39d5f75fb01d09b9ULL, 0x4cc6bab68bf96274ULL,
+	0x2425ba9bce122613ULL, 0xcffc34b2177bdd89ULL,
+	0x2d2f2942c196af98ULL, 0xc3fb41de9d5ad4ebULL,
+	0x387af39371fc5b7eULL, 0xf4fa125644b18a26ULL,
+	0x234cd83c273db92fULL, 0x591c4b75eaeef658ULL,
+	0x2c200e4b310d277bULL, 0x2f635e5365aab3edULL,
+	0x372811ddfd507159ULL, 0xfb3c35e83f1560e9ULL,
+	0x22790b2abe5246d8ULL, 0x3d05a1b1276d5c92ULL,
+	0x2b174df56de6d88eULL, 0x4c470a1d7148b3b6ULL,
+	0x35dd2172c9608eb1ULL, 0xdf58cca4cd9ae0a3ULL,
+	0x21aa34e7bddc592fULL, 0x2b977fe70080cc66ULL,
+	0x2a14c221ad536f7aULL, 0xf67d5fe0c0a0ff80ULL,
+	0x3499f2aa18a84b59ULL, 0xb41cb7d8f0c93f5fULL,
+	0x20e037aa4f692f18ULL, 0x1091f2e7967dc79cULL,
+	0x29184594e3437adeULL, 0x14b66fa17c1d3983ULL,
+	0x335e56fa1c145995ULL, 0x99e40b89db2487e3ULL,
+	0x201af65c518cb7fdULL, 0x802e873628f6d4eeULL,
+	0x2821b3f365efe5fcULL, 0xe03a2903b3348a2aULL,
+	0x322a20f03f6bdf7cULL, 0x1848b344a001acb4ULL,
+	0x3eb4a92c4f46d75bULL, 0x1e5ae015c80217e1ULL,
+	0x2730e9bbb18c4698ULL, 0xf2f8cc0d9d014eedULL,
+	0x30fd242a9def583fULL, 0x2fb6ff110441a2a8ULL,
+	0x3d3c6d35456b2e4eULL, 0xfba4bed545520b52ULL,
+	0x2645c4414b62fcf1ULL, 0x5d46f7454b534713ULL,
+	0x2fd735519e3bbc2dULL, 0xb498b5169e2818d8ULL,
+	0x3bcd02a605caab39ULL, 0x21bee25c45b21f0eULL,
+	0x256021a7c39eab03ULL, 0xb5174d79ab8f5369ULL,
+	0x2eb82a11b48655c4ULL, 0xa25d20d816732843ULL,
+	0x3a66349621a7eb35ULL, 0xcaf4690e1c0ff253ULL,
+	0x247fe0ddd508f301ULL, 0x9ed8c1a8d189f774ULL,
+	0x2d9fd9154a4b2fc2ULL, 0x068ef21305ec7551ULL,
+	0x3907cf5a9cddfbb2ULL, 0x8832ae97c76792a5ULL,
+	0x23a4e198a20abd4fULL, 0x951fad1edca0bba8ULL,
+	0x2c8e19feca8d6ca3ULL, 0x7a67986693c8ea91ULL,
+	0x37b1a07e7d30c7ccULL, 0x59017e8038bb2536ULL,
+	0x22cf044f0e3e7cdfULL, 0xb7a0ef102374f742ULL,
+	0x2b82c562d1ce1c17ULL, 0xa5892ad42c523512ULL,
+	0x366376bb8641a31dULL, 0x8eeb75893766c256ULL,
+	0x21fe2a3533e905f2ULL, 0x79532975c2a03976ULL,
+	0x2a7db4c280e3476fULL, 0x17a7f3d3334847d4ULL,
+	0x351d21f3211c194aULL, 0xdd91f0c8001a59c8ULL,
+	0x21323537f4b18fceULL, 0xca7b367d0010781dULL,
+	0x297ec285f1ddf3c2ULL, 0x7d1a041c40149625ULL,
+	0x33de73276e5570b3ULL, 0x1c6085235019bbaeULL,
+	0x206b07f8a4f5666fULL, 0xf1bc53361210154dULL,
+	0x2885c9f6ce32c00bULL, 0xee2b680396941aa0ULL,
+	0x32a73c7481bf700eULL, 0xe9b642047c392148ULL,
+	0x3f510b91a22f4c12ULL, 0xa423d2859b476999ULL,
+	0x2792a73b055d8f8bULL, 0xa6966393810ca200ULL,
+	0x31775109c6b4f36eULL, 0x903bfc78614fca80ULL,
+	0x3dd5254c3862304aULL, 0x344afb9679a3bd20ULL,
+	0x26a5374fa33d5e2eULL, 0x60aedd3e0c065634ULL,
+	0x304e85238c0cb5b9ULL, 0xf8da948d8f07ebc1ULL,
+	0x3c62266c6f0fe328ULL, 0x771139b0f2c9e6b1ULL,
+	0x25bd5803c569edf9ULL, 0x4a6ac40e97be302fULL,
+	0x2f2cae04b6c46977ULL, 0x9d0575123dadbc3aULL,
+	0x3af7d985e47583d5ULL, 0x8446d256cd192b49ULL,
+	0x24dae7f3aec97265ULL, 0x72ac4376402fbb0eULL,
+	0x2e11a1f09a7bcefeULL, 0xcf575453d03ba9d1ULL,
+	0x39960a6cc11ac2beULL, 0x832d2968c44a9445ULL,
+	0x23fdc683f8b0b9b7ULL, 0x11fc39e17aae9cabULL,
+	0x2cfd3824f6dce824ULL, 0xd67b4859d95a43d6ULL,
+	0x383c862e3494222eULL, 0x0c1a1a704fb0d4ccULL,
+	0x2325d3dce0dc955cULL, 0xc790508631ce84ffULL,
+	0x2bef48d41913bab3ULL, 0xf97464a7be42263fULL,
+	0x36eb1b091f58a960ULL, 0xf7d17dd1add2afcfULL,
+	0x2252f0e5b39769dcULL, 0x9ae2eea30ca3ade1ULL,
+	0x2ae7ad1f207d4453ULL, 0xc19baa4bcfcc995aULL,
+	0x35a19866e89c9568ULL, 0xb20294dec3bfbfb0ULL,
+	0x2184ff405161dd61ULL, 0x6f419d0b3a57d7ceULL,
+	0x29e63f1065ba54b9ULL, 0xcb12044e08edcdc2ULL,
+	0x345fced47f28e9e8ULL, 0x3dd685618b294132ULL,
+	0x20bbe144cf799231ULL, 0x26a6135cf6f9c8bfULL,
+	0x28ead9960357f6bdULL, 0x704f983434b83aefULL,
+	0x33258ffb842df46cULL, 0xcc637e4141e649abULL,
+	0x3feef3fa65397187ULL, 0xff7c5dd1925fdc15ULL,
+	0x27f5587c7f43e6f4ULL, 0xffadbaa2fb7be98dULL,
+	0x31f2ae9b9f14e0b2ULL, 0x3f99294bba5ae3f1ULL,
+	0x3e6f5a4286da18deULL, 0xcf7f739ea8f19cedULL,
+	0x2705986994484f8bULL, 0x41afa84329970214ULL,
+	0x30c6fe83f95a636eULL, 0x121b9253f3fcc299ULL,
+	0x3cf8be24f7b0fc49ULL, 0x96a276e8f0fbf33fULL,
+	0x261b76d71ace9dadULL, 0xfe258a51969d7808ULL,
+	0x2fa2548ce1824519ULL, 0x7daeece5fc44d609ULL,
+	0x3b8ae9b019e2d65fULL, 0xdd1aa81f7b560b8cULL,
+	0x2536d20e102dc5fbULL, 0xea30a913ad15c738ULL,
+	0x2e8486919439377aULL, 0xe4bcd358985b3905ULL,
+	0x3a25a835f9478559ULL, 0x9dec082ebe720746ULL,
+	0x24578921bbccb358ULL, 0x02b3851d3707448cULL,
+	0x2d6d6b6a2abfe02eULL, 0x0360666484c915afULL,
+	0x38c8c644b56fd839ULL, 0x84387ffda5fb5b1bULL,
+	0x237d7beaf165e723ULL, 0xf2a34ffe87bd18f1ULL,
+	0x2c5cdae5adbf60ecULL, 0xef4c23fe29ac5f2dULL,
+	0x3774119f192f3928ULL, 0x2b1f2cfdb41776f8ULL,
+	0x22a88b036fbd83b9ULL, 0x1af37c1e908eaa5bULL,
+	0x2b52adc44bace4a7ULL, 0x61b05b2634b254f2ULL,
+	0x362759355e981dd1ULL, 0x3a1c71efc1deea2eULL,
+	0x21d897c15b1f12a2ULL, 0xc451c735d92b525dULL,
+	0x2a4ebdb1b1e6d74bULL, 0x756639034f7626f4ULL,
+	0x34e26d1e1e608d1eULL, 0x52bfc7442353b0b1ULL,
+	0x210d8432d2fc5832ULL, 0xf3b7dc8a96144e6fULL,
+	0x2950e53f87bb6e3fULL, 0xb0a5d3ad3b99620bULL,
+	0x33a51e8f69aa49cfULL, 0x9ccf48988a7fba8dULL,
+	0x20473319a20a6e21ULL, 0xc2018d5f568fd498ULL,
+	0x2858ffe00a8d09aaULL, 0x3281f0b72c33c9beULL,
+	0x326f3fd80d304c14ULL, 0xbf226ce4f740bc2eULL,
+	0x3f0b0fce107c5f19ULL, 0xeeeb081e3510eb39ULL,
+	0x2766e9e0ca4dbb70ULL, 0x3552e512e12a9304ULL,
+	0x3140a458fce12a4cULL, 0x42a79e57997537c5ULL,
+	0x3d90cd6f3c1974dfULL, 0x535185ed7fd285b6ULL,
+	0x267a8065858fe90bULL, 0x9412f3b46fe39392ULL,
+	0x3019207ee6f3e34eULL, 0x7917b0a18bdc7876ULL,
+	0x3c1f689ea0b0dc22ULL, 0x175d9cc9eed39694ULL,
+	0x2593a163246e8995ULL, 0x4e9a81fe35443e1cULL,
+	0x2ef889bbed8a2bfaULL, 0xa241227dc2954da3ULL,
+	0x3ab6ac2ae8ecb6f9ULL, 0x4ad16b1d333aa10cULL,
+	0x24b22b9ad193f25bULL, 0xcec2e2f24004a4a8ULL,
+	0x2ddeb68185f8eef2ULL, 0xc2739baed005cdd2ULL,
+	0x39566421e7772aafULL, 0x7310829a84074146ULL,
+	0x23d5fe9530aa7aadULL, 0xa7ea51a0928488ccULL,
+	0x2ccb7e3a7cd51959ULL, 0x11e4e608b725aaffULL,
+	0x37fe5dc91c0a5fafULL, 0x565e1f8ae4ef15beULL,
+	0x22fefa9db1867bcdULL, 0x95fad3b6cf156d97ULL,
+	0x2bbeb9451de81ac0ULL, 0xfb7988a482dac8fdULL,
+	0x36ae679665622171ULL, 0x3a57eacda3917b3cULL,
+	0x222d00bdff5d54e6ULL, 0xc476f2c0863aed06ULL,
+	0x2ab840ed7f34aa20ULL, 0x7594af70a7c9a847ULL,
+	0x35665128df01d4a8ULL, 0x92f9db4cd1bc1258ULL,
+	0x215ff2b98b6124e9ULL, 0x5bdc291003158b77ULL,
+	0x29b7ef67ee396e23ULL, 0xb2d3335403daee55ULL,
+	0x3425eb41e9c7c9acULL, 0x9f88002904d1a9eaULL,
+	0x2097b309321cde0bULL, 0xe3b50019a3030a33ULL,
+	0x28bd9fcb7ea4158eULL, 0xdca240200bc3ccbfULL,
+	0x32ed07be5e4d1af2ULL, 0x93cad0280eb4bfefULL,
+	0x3fa849adf5e061afULL, 0x38bd84321261efebULL,
+	0x27c92e0cb9ac3d0dULL, 0x8376729f4b7d35f3ULL,
+	0x31bb798fe8174c50ULL, 0xe4540f471e5c836fULL,
+	0x3e2a57f3e21d1f65ULL, 0x1d691318e5f3a44bULL,
+	0x26da76f86d52339fULL, 0x3261abef8fb846afULL,
+	0x309114b688a6c086ULL, 0xfefa16eb73a6585bULL,
+	0x3cb559e42ad070a8ULL, 0xbeb89ca6508fee71ULL,
+	0x25f1582e9ac24669ULL, 0x773361e7f259f507ULL,
+	0x2f6dae3a4172d803ULL, 0xd5003a61eef07249ULL,
+	0x3b4919c8d1cf8e04ULL, 0xca4048fa6aac8edbULL,
+	0x250db01d8321b8c2ULL, 0xfe682d9c82abd949ULL,
+	0x2e511c24e3ea26f3ULL, 0xbe023903a356cf9bULL,
+	0x39e5632e1ce4b0b0ULL, 0xad82c7448c2c8382ULL,
+	0x242f5dfcd20eee6eULL, 0x6c71bc8ad79bd231ULL,
+	0x2d3b357c0692aa0aULL, 0x078e2bad8d82c6bdULL,
+	0x388a02db0837548cULL, 0x8971b698f0e3786dULL,
+	0x235641c8e52294d7ULL, 0xd5e7121f968e2b44ULL,
+	0x2c2bd23b1e6b3a0dULL, 0xcb60d6a77c31b615ULL,
+	0x3736c6c9e6060891ULL, 0x3e390c515b3e239aULL,
+	0x22823c3e2fc3c55aULL, 0xc6e3a7b2d906d640ULL,
+	0x2b22cb4dbbb4b6b1ULL, 0x789c919f8f488bd0ULL,
+	0x35eb7e212aa1e45dULL, 0xd6c3b607731aaec4ULL,
+	0x21b32ed4baa52ebaULL, 0xa63a51c4a7f0ad3bULL,
+	0x2a1ffa89e94e7a69ULL, 0x4fc8e635d1ecd88aULL,
+	0x34a7f92c63a21903ULL, 0xa3bb1fc346680eacULL,
+	0x20e8fbbbbe454fa2ULL, 0x4654f3da0c01092cULL,
+	0x29233aaaadd6a38aULL, 0xd7ea30d08f014b76ULL,
+	0x336c0955594c4c6dULL, 0x8de4bd04b2c19e54ULL,
+	0x202385d557cfafc4ULL, 0x78aef622efb902f5ULL,
+	0x282c674aadc39bb5ULL, 0x96dab3ababa743b2ULL,
+	0x3237811d593482a2ULL, 0xfc9160969691149eULL,
+	0x3ec56164af81a34bULL, 0xbbb5b8bc3c3559c5ULL,
+	0x273b5cdeedb1060fULL, 0x55519375a5a1581bULL,
+	0x310a3416a91d4793ULL, 0x2aa5f8530f09ae22ULL,
+	0x3d4cc11c53649977ULL, 0xf54f7667d2cc19abULL,
+	0x264ff8b1b41edfeaULL, 0xf951aa00e3bf900bULL,
+	0x2fe3f6de212697e5ULL, 0xb7a614811caf740dULL,
+	0x3bdcf495a9703ddfULL, 0x258f99a163db5111ULL,
+	0x256a18dd89e626abULL, 0x7779c004de6912abULL,
+	0x2ec49f14ec5fb056ULL, 0x5558300616035755ULL,
+	0x3a75c6da27779c6bULL, 0xeaae3c079b842d2aULL,
+	0x24899c4858aac1c3ULL, 0x72ace584c1329c3bULL,
+	0x2dac035a6ed57234ULL, 0x4f581ee5f17f4349ULL,
+	0x391704310a8acec1ULL, 0x632e269f6ddf141bULL,
+	0x23ae629ea696c138ULL, 0xddfcd823a4ab6c91ULL,
+	0x2c99fb46503c7187ULL, 0x157c0e2c8dd647b5ULL,
+	0x37c07a17e44b8de8ULL, 0xdadb11b7b14bd9a3ULL,
+	0x22d84c4eeeaf38b1ULL, 0x88c8eb12cecf6806ULL,
+	0x2b8e5f62aa5b06ddULL, 0xeafb25d782834207ULL,
+	0x3671f73b54f1c895ULL, 0x65b9ef4d63241289ULL,
+	0x22073a8515171d5dULL, 0x5f9435905df68b96ULL,
+	0x2a8909265a5ce4b4ULL, 0xb77942f475742e7bULL,
+	0x352b4b6ff0f41de1ULL, 0xe55793b192d13a1aULL,
+	0x213b0f25f69892adULL, 0x2f56bc4efbc2c450ULL,
+	0x2989d2ef743eb758ULL, 0x7b2c6b62bab37564ULL,
+	0x33ec47ab514e652eULL, 0x99f7863b696052bdULL,
+	0x2073accb12d0ff3dULL, 0x203ab3e521dc33b6ULL,
+	0x289097fdd7853f0cULL, 0x684960de6a5340a4ULL,
+	0x32b4bdfd4d668ecfULL, 0x825bb91604e810cdULL,
+	0x3f61ed7ca0c03283ULL, 0x62f2a75b86221500ULL,
+	0x279d346de4781f92ULL, 0x1dd7a89933d54d20ULL,
+	0x318481895d962776ULL, 0xa54d92bf80caa068ULL,
+	0x3de5a1ebb4fbb154ULL, 0x4ea0f76f60fd4882ULL,
+	0x26af8533511d4ed4ULL, 0xb1249aa59c9e4d51ULL,
+	0x305b66802564a289ULL, 0xdd6dc14f03c5e0a5ULL,
+	0x3c7240202ebdcb2cULL, 0x54c931a2c4b758cfULL,
+	0x25c768141d369efbULL, 0xb4fdbf05baf29781ULL,
+	0x2f394219248446baULL, 0xa23d2ec729af3d62ULL,
+	0x3b07929f6da55869ULL, 0x4acc7a78f41b0cbaULL,
+	0x24e4bba3a4875741ULL, 0xcebfcc8b9890e7f4ULL,
+	0x2e1dea8c8da92d12ULL, 0x426fbfae7eb521f1ULL,
+	0x39a5652fb1137856ULL, 0xd30baf9a1e626a6dULL,
+	0x24075f3dceac2b36ULL, 0x43e74dc052fd8285ULL,
+	0x2d09370d42573603ULL, 0xd4e1213067bce326ULL,
+	0x384b84d092ed0384ULL, 0xca19697c81ac1befULL,
+	0x232f33025bd42232ULL, 0xfe4fe1edd10b9175ULL,
+	0x2bfaffc2f2c92abfULL, 0xbde3da69454e75d3ULL,
+	0x36f9bfb3af7b756fULL, 0xad5cd10396a21347ULL,
+	0x225c17d04dad2965ULL, 0xcc5a02a23e254c0dULL,
+	0x2af31dc4611873bfULL, 0x3f70834acdae9f10ULL,
+	0x35afe535795e90afULL, 0x0f4ca41d811a46d4ULL,
+	0x218def416bdb1a6dULL, 0x698fe69270b06c44ULL,
+	0x29f16b11c6d1e108ULL, 0xc3f3e0370cdc8755ULL,
+	0x346dc5d63886594aULL, 0xf4f0d844d013a92bULL,
+	0x20c49ba5e353f7ceULL, 0xd916872b020c49bbULL,
+	0x28f5c28f5c28f5c2ULL, 0x8f5c28f5c28f5c29ULL,
+	0x3333333333333333ULL, 0x3333333333333334ULL,
+	0x2000000000000000ULL, 0x0000000000000001ULL,
+	0x2800000000000000ULL, 0x0000000000000001ULL,
+	0x3200000000000000ULL, 0x0000000000000001ULL,
+	0x3e80000000000000ULL, 0x0000000000000001ULL,
+	0x2710000000000000ULL, 0x0000000000000001ULL,
+	0x30d4000000000000ULL, 0x0000000000000001ULL,
+	0x3d09000000000000ULL, 0x0000000000000001ULL,
+	0x2625a00000000000ULL, 0x0000000000000001ULL,
+	0x2faf080000000000ULL, 0x0000000000000001ULL,
+	0x3b9aca0000000000ULL, 0x0000000000000001ULL,
+	0x2540be4000000000ULL, 0x0000000000000001ULL,
+	0x2e90edd000000000ULL, 0x0000000000000001ULL,
+	0x3a35294400000000ULL, 0x0000000000000001ULL,
+	0x246139ca80000000ULL, 0x0000000000000001ULL,
+	0x2d79883d20000000ULL, 0x0000000000000001ULL,
+	0x38d7ea4c68000000ULL, 0x0000000000000001ULL,
+	0x2386f26fc1000000ULL, 0x0000000000000001ULL,
+	0x2c68af0bb1400000ULL, 0x0000000000000001ULL,
+	0x3782dace9d900000ULL, 0x0000000000000001ULL,
+	0x22b1c8c1227a0000ULL, 0x0000000000000001ULL,
+	0x2b5e3af16b188000ULL, 0x0000000000000001ULL,
+	0x3635c9adc5dea000ULL, 0x0000000000000001ULL,
+	0x21e19e0c9bab2400ULL, 0x0000000000000001ULL,
+	0x2a5a058fc295ed00ULL, 0x0000000000000001ULL,
+	0x34f086f3b33b6840ULL, 0x0000000000000001ULL,
+	0x2116545850052128ULL, 0x0000000000000001ULL,
+	0x295be96e64066972ULL, 0x0000000000000001ULL,
+	0x33b2e3c9fd0803ceULL, 0x8000000000000001ULL,
+	0x204fce5e3e250261ULL, 0x1000000000000001ULL,
+	0x2863c1f5cdae42f9ULL, 0x5400000000000001ULL,
+	0x327cb2734119d3b7ULL, 0xa900000000000001ULL,
+	0x3f1bdf10116048a5ULL, 0x9340000000000001ULL,
+	0x27716b6a0adc2d67ULL, 0x7c08000000000001ULL,
+	0x314dc6448d9338c1ULL, 0x5b0a000000000001ULL,
+	0x3da137d5b0f806f1ULL, 0xb1cc800000000001ULL,
+	0x2684c2e58e9b0457ULL, 0x0f1fd00000000001ULL,
+	0x3025f39ef241c56cULL, 0xd2e7c40000000001ULL,
+	0x3c2f7086aed236c8ULL, 0x07a1b50000000001ULL,
+	0x259da6542d43623dULL, 0x04c5112000000001ULL,
+	0x2f050fe938943accULL, 0x45f6556800000001ULL,
+	0x3ac653e386b9497fULL, 0x5773eac200000001ULL,
+	0x24bbf46e3433cdefULL, 0x96a872b940000001ULL,
+	0x2deaf189c140c16bULL, 0x7c528f6790000001ULL,
+	0x3965adec3190f1c6ULL, 0x5b67334174000001ULL,
+	0x23df8cb39efa971bULL, 0xf9208008e8800001ULL,
+	0x2cd76fe086b93ce2ULL, 0xf768a00b22a00001ULL,
+	0x380d4bd8a8678c1bULL, 0xb542c80deb480001ULL,
+	0x23084f676940b791ULL, 0x5149bd08b30d0001ULL,
+	0x2bca63414390e575ULL, 0xa59c2c4adfd04001ULL,
+	0x36bcfc1194751ed3ULL, 0x0f03375d97c45001ULL,
+	0x22361d8afcc93343ULL, 0xe962029a7edab201ULL,
+	0x2ac3a4edbbfb8014ULL, 0xe3ba83411e915e81ULL,
+	0x35748e292afa601aULL, 0x1ca924116635b621ULL,
+	0x2168d8d9badc7c10ULL, 0x51e9b68adfe191d5ULL,
+	0x29c30f1029939b14ULL, 0x6664242d97d9f64aULL,
+	0x3433d2d433f881d9ULL, 0x7ffd2d38fdd073dcULL,
+	0x20a063c4a07b5127ULL, 0xeffe3c439ea2486aULL,
+	0x28c87cb5c89a2571ULL, 0xebfdcb54864ada84ULL,
+	0x32fa9be33ac0aeceULL, 0x66fd3e29a7dd9125ULL,
+	0x3fb942dc0970da82ULL, 0x00bc8db411d4f56eULL,
+	0x27d3c9c985e68891ULL, 0x4075d8908b251965ULL,
+	0x31c8bc3be7602ab5ULL, 0x90934eb4adee5fbeULL,
+	0x3e3aeb4ae1383562ULL, 0xf4b82261d969f7adULL,
+	0x26e4d30eccc3215dULL, 0xd8f3157d27e23accULL,
+	0x309e07d27ff3e9b5ULL, 0x4f2fdadc71dac97fULL,
+	0x3cc589c71ff0e422ULL, 0xa2fbd1938e517bdfULL,
+	0x25fb761c73f68e95ULL, 0xa5dd62fc38f2ed6cULL,
+	0x2f7a53a390f4323bULL, 0x0f54bbbb472fa8c6ULL,
+	0x3b58e88c75313ec9ULL, 0xd329eaaa18fb92f8ULL,
+	0x25179157c93ec73eULL, 0x23fa32aa4f9d3bdbULL,
+	0x2e5d75adbb8e790dULL, 0xacf8bf54e3848ad2ULL,
+	0x39f4d3192a721751ULL, 0x1836ef2a1c65ad86ULL,
+	0x243903efba874e92ULL, 0xaf22557a51bf8c74ULL,
+	0x2d4744eba9292237ULL, 0x5aeaead8e62f6f91ULL,
+	0x3899162693736ac5ULL, 0x31a5a58f1fbb4b75ULL,
+	0x235fadd81c2822bbULL, 0x3f07877973d50f29ULL,
+	0x2c37994e23322b6aULL, 0x0ec96957d0ca52f3ULL,
+	0x37457fa1abfeb644ULL, 0x927bc3adc4fce7b0ULL,
+	0x228b6fc50b7f31eaULL, 0xdb8d5a4c9b1e10ceULL,
+	0x2b2e4bb64e5efe65ULL, 0x9270b0dfc1e59502ULL,
+	0x35f9dea3e1f6bdfeULL, 0xf70cdd17b25efa42ULL,
+	0x21bc2b266d3a36bfULL, 0x5a680a2ecf7b5c69ULL,
+	0x2a2b35f00888c46fULL, 0x31020cba835a3384ULL,
+	0x34b6036c0aaaf58aULL, 0xfd428fe92430c065ULL,
+	0x20f1c22386aad976ULL, 0xde4999f1b69e783fULL,
+	0x292e32ac68558fd4ULL, 0x95dc006e2446164fULL,
+	0x3379bf57826af3c9ULL, 0xbb530089ad579be2ULL,
+	0x202c1796b182d85eULL, 0x1513e0560c56c16eULL,
+	0x28371d7c5de38e75ULL, 0x9a58d86b8f6c71c9ULL,
+	0x3244e4db755c7213ULL, 0x00ef0e8673478e3bULL,
+	0x3ed61e1252b38e97ULL, 0xc12ad228101971c9ULL,
+	0x2745d2cb73b0391eULL, 0xd8bac3590a0fe71eULL,
+	0x3117477e509c4766ULL, 0x8ee9742f4c93e0e6ULL,
+	0x3d5d195de4c35940ULL, 0x32a3d13b1fb8d91fULL,
+	0x265a2fdaaefa17c8ULL, 0x1fa662c4f3d387b3ULL,
+	0x2ff0bbd15ab89dbaULL, 0x278ffb7630c869a0ULL,
+	0x3beceac5b166c528ULL, 0xb173fa53bcfa8408ULL,
+	0x257412bb8ee03b39ULL, 0x6ee87c74561c9285ULL,
+	0x2ed1176a72984a07ULL, 0xcaa29b916ba3b726ULL,
+	0x3a855d450f3e5c89ULL, 0xbd4b4275c68ca4f0ULL,
+	0x24935a4b2986f9d6ULL, 0x164f09899c17e716ULL,
+	0x2db830ddf3e8b84bULL, 0x9be2cbec031de0dcULL,
+	0x39263d1570e2e65eULL, 0x82db7ee703e55912ULL,
+	0x23b7e62d668dcffbULL, 0x11c92f50626f57acULL,
+	0x2ca5dfb8c03143f9ULL, 0xd63b7b247b0b2d96ULL,
+	0x37cf57a6f03d94f8ULL, 0x4bca59ed99cdf8fcULL,
+	0x22e196c856267d1bULL, 0x2f5e78348020bb9eULL,
+	0x2b99fc7a6bb01c61ULL, 0xfb361641a028ea85ULL,
+	0x36807b99069c237aULL, 0x7a039bd208332526ULL,
+	0x22104d3fa421962cULL, 0x8c424163451ff738ULL,
+	0x2a94608f8d29fbb7ULL, 0xaf52d1bc1667f506ULL,
+	0x353978b370747aa5ULL, 0x9b27862b1c01f247ULL,
+	0x2143eb702648cca7ULL, 0x80f8b3daf181376dULL,
+	0x2994e64c2fdaffd1ULL, 0x6136e0d1ade18548ULL,
+	0x33fa1fdf3bd1bfc5ULL, 0xb98499061959e699ULL,
+	0x207c53eb856317dbULL, 0x93f2dfa3cfd83020ULL,
+	0x289b68e666bbddd2ULL, 0x78ef978cc3ce3c28ULL,
+	0x32c24320006ad547ULL, 0x172b7d6ff4c1cb32ULL,
+	0x3f72d3e800858a98ULL, 0xdcf65ccbf1f23dfeULL,
+	0x27a7c4710053769fULL, 0x8a19f9ff773766bfULL,
+	0x3191b58d40685447ULL, 0x6ca0787f5505406fULL,
+	0x3df622f090826959ULL, 0x47c8969f2a46908aULL,
+	0x26b9d5d65a5181d7ULL, 0xccdd5e237a6c1a57ULL,
+	0x30684b4bf0e5e24dULL, 0xc014b5ac590720ecULL,
+	0x3c825e1eed1f5ae1ULL, 0x3019e3176f48e927ULL,
+	0x25d17ad3543398ccULL, 0xbe102deea58d91b9ULL,
+	0x2f45d98829407effULL, 0xed94396a4ef0f627ULL,
+	0x3b174fea33909ebfULL, 0xe8f947c4e2ad33b0ULL,
+	0x24ee91f2603a6337ULL, 0xf19bccdb0dac404eULL,
+	0x2e2a366ef848fc05ULL, 0xee02c011d1175062ULL,
+	0x39b4c40ab65b3b07ULL, 0x69837016455d247aULL,
+	0x2410fa86b1f904e4ULL, 0xa1f2260deb5a36ccULL,
+	0x2d1539285e77461dULL, 0xca6eaf916630c47fULL,
+	0x385a8772761517a5ULL, 0x3d0a5b75bfbcf59fULL,
+	0x233894a789cd2ec7ULL, 0x4626792997d61984ULL,
+	0x2c06b9d16c407a79ULL, 0x17b01773fdcb9fe4ULL,
+	0x37086845c7509917ULL, 0x5d9c1d50fd3e87ddULL,
+	0x2265412b9c925faeULL, 0x9a8192529e4714ebULL,
+	0x2afe917683b6f79aULL, 0x4121f6e745d8da25ULL,
+	0x35be35d424a4b580ULL, 0xd16a74a1174f10aeULL,
+	0x2196e1a496e6f170ULL, 0x82e288e4ae916a6dULL,
+	0x29fc9a0dbca0adccULL, 0xa39b2b1dda35c508ULL,
+	0x347bc0912bc8d93fULL, 0xcc81f5e550c3364aULL,
+	0x20cd585abb5d87c7ULL, 0xdfd139af527a01efULL,
+	0x2900ae716a34e9b9ULL, 0xd7c5881b2718826aULL,
+	0x3340da0dc4c22428ULL, 0x4db6ea21f0dea304ULL,
+	0x200888489af95699ULL, 0x30925255368b25e3ULL,
+	0x280aaa5ac1b7ac3fULL, 0x7cb6e6ea842def5cULL,
+	0x320d54f17225974fULL, 0x5be4a0a525396b32ULL,
+	0x3e90aa2dceaefd23ULL, 0x32ddc8ce6e87c5ffULL,
+	0x271a6a5ca12d5e35ULL, 0xffca9d810514dbbfULL,
+	0x30e104f3c978b5c3ULL, 0x7fbd44e1465a12afULL,
+	0x3d194630bbd6e334ULL, 0x5fac961997f0975bULL,
+	0x262fcbde75664e00ULL, 0xbbcbddcffef65e99ULL,
+	0x2fbbbed612bfe180ULL, 0xeabed543feb3f63fULL,
+	0x3baaae8b976fd9e1ULL, 0x256e8a94fe60f3cfULL,
+	0x254aad173ea5e82cULL, 0xb765169d1efc9861ULL,
+	0x2e9d585d0e4f6237ULL, 0xe53e5c4466bbbe7aULL,
+	0x3a44ae7451e33ac5ULL, 0xde8df355806aae18ULL,
+	0x246aed08b32e04bbULL, 0xab18b8157042accfULL,
+	0x2d85a84adff985eaULL, 0x95dee61acc535803ULL,
+	0x38e7125d97f7e765ULL, 0x3b569fa17f682e03ULL,
+	0x23906b7a7efaf09fULL, 0x451623c4efa11cc2ULL,
+	0x2c7486591eb9acc7ULL, 0x165bacb62b8963f3ULL,
+	0x3791a7ef666817f8ULL, 0xdbf297e3b66bbcefULL,
+	0x22bb08f5a0010efbULL, 0x89779eee52035616ULL,
+	0x2b69cb33080152baULL, 0x6bd586a9e6842b9bULL,
+	0x36443dffca01a769ULL, 0x06cae85460253682ULL,
+	0x21eaa6bfde4108a1ULL, 0xa43ed134bc174211ULL,
+	0x2a65506fd5d14acaULL, 0x0d4e8581eb1d1295ULL,
+	0x34fea48bcb459d7cULL, 0x90a226e265e4573bULL,
+	0x211f26d75f0b826dULL, 0xda65584d7faeb685ULL,
+	0x2966f08d36ce6309ULL, 0x50feae60df9a6426ULL,
+	0x33c0acb08481fbcbULL, 0xa53e59f91780fd2fULL,
+	0x20586bee52d13d5fULL, 0x4746f83baeb09e3eULL,
+	0x286e86e9e7858cb7ULL, 0x1918b64a9a5cc5cdULL,
+	0x328a28a46166efe4ULL, 0xdf5ee3dd40f3f740ULL,
+	0x3f2cb2cd79c0abdeULL, 0x17369cd49130f510ULL,
+	0x277befc06c186b6aULL, 0xce822204dabe992aULL,
+	0x315aebb0871e8645ULL, 0x8222aa86116e3f75ULL,
+	0x3db1a69ca8e627d6ULL, 0xe2ab552795c9cf52ULL,
+	0x268f0821e98fd8e6ULL, 0x4dab1538bd9e2193ULL,
+	0x3032ca2a63f3cf1fULL, 0xe115da86ed05a9f8ULL,
+	0x3c3f7cb4fcf0c2e7ULL, 0xd95b5128a8471476ULL,
+	0x25a7adf11e1679d0ULL, 0xe7d912b9692c6ccaULL,
+	0x2f11996d659c1845ULL, 0x21cf5767c37787fcULL,
+	0x3ad5ffc8bf031e56ULL, 0x6a432d41b45569fbULL,
+	0x24c5bfdd7761f2f6ULL, 0x0269fc4910b5623dULL,
+	0x2df72fd4d53a6fb3ULL, 0x83047b5b54e2baccULL,
+	0x3974fbca0a890ba0ULL, 0x63c59a322a1b697fULL,
+	0x23e91d5e4695a744ULL, 0x3e5b805f5a5121f0ULL,
+	0x2ce364b5d83b1115ULL, 0x4df2607730e56a6cULL,
+	0x381c3de34e49d55aULL, 0xa16ef894fd1ec506ULL,
+	0x2311a6ae10ee2558ULL, 0xa4e55b5d1e333b24ULL,
+	0x2bd610599529aeaeULL, 0xce1eb23465c009edULL,
+	0x36cb946ffa741a5aULL, 0x81a65ec17f300c68ULL,
+	0x223f3cc5fc889078ULL, 0x9107fb38ef7e07c1ULL,
+	0x2acf0bf77baab496ULL, 0xb549fa072b5d89b1ULL,
+	0x3582cef55a9561bcULL, 0x629c7888f634ec1eULL,
+	0x2171c159589d5d15ULL, 0xbda1cb5599e11393ULL,
+	0x29ce31afaec4b45bULL, 0x2d0a3e2b00595877ULL,
+	0x3441be1b9a75e171ULL, 0xf84ccdb5c06fae95ULL,
+	0x20a916d14089ace7ULL, 0x3b3000919845cd1dULL,
+	0x28d35c8590ac1821ULL, 0x09fc00b5fe574065ULL,
+	0x330833a6f4d71e29ULL, 0x4c7b00e37ded107eULL,
+	0x3fca4090b20ce5b3ULL, 0x9f99c11c5d68549dULL,
+	0x27de685a6f480f90ULL, 0x43c018b1ba6134e2ULL,
+	0x31d602710b1a1374ULL, 0x54b01ede28f9821bULL,
+	0x3e4b830d4de09851ULL, 0x69dc2695b337e2a1ULL,
+	0x26ef31e850ac5f32ULL, 0xe229981d9002eda5ULL,
+	0x30aafe6264d776ffULL, 0x9ab3fe24f403a90eULL,
+	0x3cd5bdfafe0d54bfULL, 0x8160fdae31049351ULL,
+	0x260596bcdec854f7ULL, 0xb0dc9e8cdea2dc13ULL,
+	0x2f86fc6c167a6a35ULL, 0x9d13c630164b9318ULL,
+	0x3b68bb871c1904c3ULL, 0x0458b7bc1bde77ddULL,
+	0x25217534718fa2f9ULL, 0xe2b772d5916b0aebULL,
+	0x2e69d2818df38bb8ULL, 0x5b654f8af5c5cda5ULL,
+	0x3a044721f1706ea6ULL, 0x723ea36db337410eULL,
+	0x2442ac7536e64528ULL, 0x07672624900288a9ULL,
+	0x2d535792849fd672ULL, 0x0940efadb4032ad3ULL,
+	0x38a82d7725c7cc0eULL, 0x8b912b992103f588ULL,
+	0x23691c6a779cdf89ULL, 0x173abb3fb4a27975ULL,
+	0x2c4363851584176bULL, 0x5d096a0fa1cb17d2ULL,
+	0x37543c665ae51d46ULL, 0x344bc4938a3dddc7ULL,
+	0x2294a5bff8cf324bULL, 0xe0af5adc3666aa9cULL,
+	0x2b39cf2ff702fedeULL, 0xd8db319344005543ULL,
+	0x360842fbf4c3be96ULL, 0x8f11fdf815006a94ULL,
+	0x21c529dd78fa571eULL, 0x196b3ebb0d20429dULL,
+	0x2a367454d738ece5ULL, 0x9fc60e69d0685344ULL,
+	0x34c4116a0d07281fULL, 0x07b7920444826815ULL,
+	0x20fa8ae248247913ULL, 0x64d2bb42aad1810dULL,
+	0x29392d9ada2d9758ULL, 0x3e076a135585e150ULL,
+	0x3387790190b8fd2eULL, 0x4d8944982ae759a4ULL,
+	0x2034aba0fa739e3cULL, 0xf075cadf1ad09807ULL,
+	0x2841d689391085ccULL, 0x2c933d96e184be08ULL,
+	0x32524c2b8754a73fULL, 0x37b80cfc99e5ed8aULL,
+	0x3ee6df366929d10fULL, 0x05a6103bc05f68edULL,
+	0x27504b8201ba22a9ULL, 0x6387ca25583ba194ULL,
+	0x31245e628228ab53ULL, 0xbc69bcaeae4a89f9ULL,
+	0x3d6d75fb22b2d628ULL, 0xab842bda59dd2c77ULL,
+	0x266469bcf5afc5d9ULL, 0x6b329b68782a3bcbULL,
+	0x2ffd842c331bb74fULL, 0xc5ff42429634cabdULL,
+	0x3bfce5373fe2a523ULL, 0xb77f12d33bc1fd6dULL,
+	0x257e0f4287eda736ULL, 0x52af6bc405593e64ULL,
+	0x2edd931329e91103ULL, 0xe75b46b506af8dfdULL,
+	0x3a94f7d7f4635544ULL, 0xe1321862485b717cULL,
+	0x249d1ae6f8be154bULL, 0x0cbf4f3d6d3926eeULL,
+	0x2dc461a0b6ed9a9dULL, 0xcfef230cc88770a9ULL,
+	0x39357a08e4a90145ULL, 0x43eaebcffaa94cd3ULL,
+	0x23c16c458ee9a0cbULL, 0x4a72d361fca9d004ULL,
+	0x2cb1c756f2a408feULL, 0x1d0f883a7bd44405ULL,
+	0x37de392caf4d0b3dULL, 0xa4536a491ac95506ULL,
+	0x22eae3bbed902706ULL, 0x86b4226db0bdd524ULL,
+	0x2ba59caae8f430c8ULL, 0x28612b091ced4a6dULL,
+	0x368f03d5a3313cfaULL, 0x327975cb64289d08ULL,
+	0x2219626585fec61cULL, 0x5f8be99f1e996225ULL,
+	0x2a9fbafee77e77a3ULL, 0x776ee406e63fbaaeULL,
+	0x3547a9bea15e158cULL, 0x554a9d089fcfa95aULL,
+	0x214cca1724dacd77ULL, 0xb54ea22563e1c9d8ULL,
+	0x299ffc9cee1180d5ULL, 0xa2a24aaebcda3c4eULL,
+	0x3407fbc42995e10bULL, 0x0b4add5a6c10cb62ULL,
+	0x2084fd5a99fdaca6ULL, 0xe70eca58838a7f1dULL,
+	0x28a63cb1407d17d0ULL, 0xa0d27ceea46d1ee4ULL,
+	0x32cfcbdd909c5dc4ULL, 0xc9071c2a4d88669dULL,
+	0x3f83bed4f4c37535ULL, 0xfb48e334e0ea8045ULL,
+	0x27b2574518fa2941ULL, 0xbd0d8e010c92902bULL,
+	0x319eed165f38b392ULL, 0x2c50f1814fb73436ULL,
+	0x3e06a85bf706e076ULL, 0xb7652de1a3a50143ULL,
+	0x26c429397a644c4aULL, 0x329f3cad064720caULL,
+	0x30753387d8fd5f5cULL, 0xbf470bd847d8e8fdULL,
+	0x3c928069cf3cb733ULL, 0xef18cece59cf233cULL,
+	0x25db90422185f280ULL, 0x756f8140f8217605ULL,
+	0x2f527452a9e76f20ULL, 0x92cb61913629d387ULL,
+	0x3b27116754614ae8ULL, 0xb77e39f583b44868ULL,
+	0x24f86ae094bcced1ULL, 0x72aee4397250ad41ULL,
+	0x2e368598b9ec0285ULL, 0xcf5a9d47cee4d891ULL,
+	0x39c426fee8670327ULL, 0x43314499c29e0eb6ULL,
+	0x241a985f514061f8ULL, 0x89fecae019a2c932ULL,
+	0x2d213e7725907a76ULL, 0xac7e7d98200b7b7eULL,
+	0x38698e14eef49914ULL, 0x579e1cfe280e5a5dULL,
+	0x2341f8cd1558dfacULL, 0xb6c2d21ed908f87bULL,
+	0x2c1277005aaf1797ULL, 0xe47386a68f4b3699ULL,
+	0x371714c0715add7dULL, 0xdd906850331e043fULL,
+	0x226e6cf846d8ca6eULL, 0xaa7a41321ff2c2a8ULL,
+	0x2b0a0836588efd0aULL, 0x5518d17ea7ef7352ULL,
+	0x35cc8a43eeb2bc4cULL, 0xea5f05de51eb5026ULL,
+	0x219fd66a752fb5b0ULL, 0x127b63aaf3331218ULL,
+	0x2a07cc05127ba31cULL, 0x171a3c95afffd69eULL,
+	0x3489bf06571a8be3ULL, 0x1ce0cbbb1bffcc45ULL,
+	0x20d61763f670976dULL, 0xf20c7f54f17fdfabULL,
+	0x290b9d3cf40cbd49ULL, 0x6e8f9f2a2ddfd796ULL,
+	0x334e848c310fec9bULL, 0xca3386f4b957cd7bULL,
+	0x201112d79ea9f3e1ULL, 0x5e603458f3d6e06dULL,
+	0x2815578d865470d9ULL, 0xb5f8416f30cc9888ULL,
+	0x321aad70e7e98d10ULL, 0x237651cafcffbeaaULL,
+	0x3ea158cd21e3f054ULL, 0x2c53e63dbc3fae55ULL,
+	0x2724d780352e7634ULL, 0x9bb46fe695a7ccf5ULL,
+	0x30ee0d60427a13c1ULL, 0xc2a18be03b11c033ULL,
+	0x3d2990b8531898b2ULL, 0x3349eed849d6303fULL,
+	0x2639fa7333ef5f6fULL, 0x600e35472e25de28ULL,
+	0x2fc8791000eb374bULL, 0x3811c298f9af55b1ULL,
+	0x3bba97540126051eULL, 0x0616333f381b2b1eULL,
+	0x25549e9480b7c332ULL, 0xc3cde0078310faf3ULL,
+	0x2ea9c639a0e5b3ffULL, 0x74c1580963d539afULL,
+	0x3a5437c8091f20ffULL, 0x51f1ae0bbcca881bULL,
+	0x2474a2dd05b3749fULL, 0x93370cc755fe9511ULL,
+	0x2d91cb94472051c7ULL, 0x7804cff92b7e3a55ULL,
+	0x38f63e7958e86639ULL, 0x560603f7765dc8eaULL,
+	0x2399e70bd7913fe3ULL, 0xd5c3c27aa9fa9d93ULL,
+	0x2c8060cecd758fdcULL, 0xcb34b319547944f7ULL,
+	0x37a0790280d2f3d3ULL, 0xfe01dfdfa9979635ULL,
+	0x22c44ba19083d864ULL, 0x7ec12bebc9febde1ULL,
+	0x2b755e89f4a4ce7dULL, 0x9e7176e6bc7e6d59ULL,
+	0x3652b62c71ce021dULL, 0x060dd4a06b9e08b0ULL,
+	0x21f3b1dbc720c152ULL, 0x23c8a4e44342c56eULL,
+	0x2a709e52b8e8f1a6ULL, 0xacbace1d541376c9ULL,
+	0x350cc5e767232e10ULL, 0x57e981a4a918547bULL,
+	0x2127fbb0a075fccaULL, 0x36f1f106e9af34cdULL,
+	0x2971fa9cc8937bfcULL, 0xc4ae6d48a41b0201ULL,
+	0x33ce7943fab85afbULL, 0xf5da089acd21c281ULL,
+	0x20610bca7cb338ddULL, 0x79a84560c0351991ULL,
+	0x28794ebd1be00714ULL, 0xd81256b8f0425ff5ULL,
+	0x3297a26c62d808daULL, 0x0e16ec672c52f7f2ULL,
+	0x3f3d8b077b8e0b10ULL, 0x919ca780f767b5eeULL,
+	0x278676e4ad38c6eaULL, 0x5b01e8b09aa0d1b5ULL,
+};
+
+static inline
+int floorLog2Pow10(int e)
+{
+	return (e * 1741647) >> 19;
+}
+
+static inline
+int floorLog10Pow2(int e)
+{
+	return (e * 315653) >> 20;
+}
+
+static inline
+int floorLog10ThreeQuartersPow2(int e)
+{
+	return (e * 315653 - 131237) >> 20;
+}
+
+// floor(g * cp / 2^127), odd when the dropped bits are not all zero
+static inline
+uint64_t roundToOdd(const uint64_t* g, uint64_t cp)
+{
+	Value128 high = fullMultiplication(g[0], cp);
+	Value128 low = fullMultiplication(g[1], cp);
+	uint64_t mid = high.low + low.high;
+	uint64_t carry = (mid < high.low);
+	uint64_t v = ((high.high + carry) << 1) | (mid >> 63);
+	return v | ((mid & 0x7FFFFFFFFFFFFFFFULL) != 0);
+}
+
+// v = c * 2^q, c != 0, returns digits * 10^exponent
+static
+uint64_t toDecimal(uint64_t c, int q, int& exponent)
+{
+	uint64_t out = c & 1;	// the boundaries belong to the interval when c is even
+	uint64_t cb = c << 2;
+	uint64_t cbr = cb + 2;
+	uint64_t cbl;
+	int k;
+	if (c != ((uint64_t)1 << MantissaBits) || q == MinimumExponent - MantissaBits + 1) {
+		cbl = cb - 2;
+		k = floorLog10Pow2(q);
+	}else {
+		// the lower neighbour is closer
+		cbl = cb - 1;
+		k = floorLog10ThreeQuartersPow2(q);
+	}
+	int h = q + floorLog2Pow10(-k) + 2;
+	const uint64_t* g = &powerOfTen126[(-k - SmallestCachedPowerOfTen) * 2];
+	uint64_t vb = roundToOdd(g, cb << h);
+	uint64_t vbl = roundToOdd(g, cbl << h);
+	uint64_t vbr = roundToOdd(g, cbr << h);
+	uint64_t s = vb >> 2;
+	exponent = k;
+	if (s >= 10) {
+		uint64_t sp10 = (s / 10) * 10;
+		uint64_t tp10 = sp10 + 10;
+		bool upin = vbl + out <= (sp10 << 2);
+		bool wpin = (tp10 << 2) + out <= vbr;
+		if (upin != wpin) {
+			return upin ? sp10 : tp10;
+		}
+	}
+	bool uin = vbl + out <= (s << 2);
+	bool win = ((s + 1) << 2) + out <= vbr;
+	if (uin != win) {
+		return uin ? s : s + 1;
+	}
+	uint64_t mid = (s << 2) + 2;
+	return (vb < mid || (vb == mid && !(s & 1))) ? s : s + 1;
+}
+
+static const char digitPairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+// decimal digits of v, returns their count
+static inline
+size_t writeDigits(char* dst, uint64_t v)
+{
+	char buff[20];
+	char* p = buff + sizeof(buff);
+	while (v >= 100) {
+		unsigned r = (unsigned)(v % 100);
+		v /= 100;
+		p -= 2;
+		p[0] = digitPairs[r * 2];
+		p[1] = digitPairs[r * 2 + 1];
+	}
+	if (v >= 10) {
+		p -= 2;
+		p[0] = digitPairs[v * 2];
+		p[1] = digitPairs[v * 2 + 1];
+	}else {
+		*--p = (char)('0' + v);
+	}
+	size_t n = buff + sizeof(buff) - p;
+	memcpy(dst, p, n);
+	return n;
+}
+
+size_t FormatDouble(double value, char* dst)
+{
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	char* p = dst;
+	if (bits >> 63) {
+		*p++ = '-';
+	}
+	uint64_t fraction = bits & (((uint64_t)1 << MantissaBits) - 1);
+	int biasedExponent = (int)((bits >> MantissaBits) & InfinitePower);
+	if (biasedExponent == 0 && fraction == 0) {
+		*p++ = '0';
+		return p - dst;
+	}
+	uint64_t c;
+	int q;
+	if (biasedExponent == 0) {
+		c = fraction;
+		q = MinimumExponent - MantissaBits + 1;
+	}else {
+		c = fraction | ((uint64_t)1 << MantissaBits);
+		q = biasedExponent + MinimumExponent - MantissaBits;
+	}
+	uint64_t digits;
+	int exponent;
+	if (q <= 0 && q > -MantissaBits - 1 && !(c & (((uint64_t)1 << -q) - 1))) {
+		// small integers are exact
+		digits = c >> -q;
+		exponent = 0;
+	}else {
+		digits = toDecimal(c, q, exponent);
+	}
+	while (digits % 10 == 0) {
+		digits /= 10;
+		++exponent;
+	}
+	
+	// laid out like ECMAScript Number::toString
+	char buff[20];
+	int n = (int)writeDigits(buff, digits);
+	int point = n + exponent;
+	if (n <= point && point <= 21) {
+		memcpy(p, buff, n);
+		p += n;
+		memset(p, '0', point - n);
+		p += point - n;
+	}else if (0 < point && point <= 21) {
+		memcpy(p, buff, point);
+		p += point;
+		*p++ = '.';
+		memcpy(p, buff + point, n - point);
+		p += n - point;
+	}else if (-6 < point && point <= 0) {
+		*p++ = '0';
+		*p++ = '.';
+		memset(p, '0', -point);
+		p += -point;
+		memcpy(p, buff, n);
+		p += n;
+	}else {
+		*p++ = buff[0];
+		if (n > 1) {
+			*p++ = '.';
+			memcpy(p, buff + 1, n - 1);
+			p += n - 1;
+		}
+		*p++ = 'e';
+		int e = point - 1;
+		if (e < 0) {
+			*p++ = '-';
+			e = -e;
+		}
+		p += writeDigits(p, (uint64_t)e);
+	}
+	assert(p - dst <= FormatDoubleMaxLength);
+	return p - dst;
+}
+
+size_t FormatInt64(int64_t value, char* dst)
+{
+	if (value < 0) {
+		*dst = '-';
+		return 1 + writeDigits(dst + 1, 0 - (uint64_t)value);
+	}
+	return writeDigits(dst, (uint64_t)value);
+}
+
+size_t FormatUInt64(uint64_t value, char* dst)
+{
+	return writeDigits(dst, value);
+}
+
+} // namespace json16
+
@@ -0,0 +1,28 @@
+#pragma once
+
+namespace json16 {
+
+// Number conversion straight from the source text and back.
+// p/len must cover one token that matches the JSON number grammar.
+
+// correctly rounded, independent of the C locale
+double ParseDouble(const char* p, size_t len);
+
+// return false when the token has a fraction or exponent, or does not fit
+bool ParseInt64(const char* p, size_t len, int64_t& value);
+bool ParseUInt64(const char* p, size_t len, uint64_t& value);
+
+enum {
+	FormatDoubleMaxLength = 25,		// -0.00000ddddddddddddddddd
+	FormatIntegerMaxLength = 20,
+};
+
+// Shortest text that reads back as value, value must be finite.
+// dst needs FormatDoubleMaxLength bytes, returns the length written.
+size_t FormatDouble(double value, char* dst);
+// dst needs FormatIntegerMaxLength bytes
+size_t FormatInt64(int64_t value, char* dst);
+size_t FormatUInt64(uint64_t value, char* dst);
+
+} // namespace json16
+
@@ -0,0 +1,446 @@
+#include "json16_parallel.h"
+#include "json16_builder.h"
+#include "json16_thread.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace json16 {
+
+// State of one container level between two of its tokens. The kind of the
+// container is part of the state, Doc is the level around the root value.
+enum LevelState {
+	Level_DocStart,
+	Level_DocEnd,
+	Level_ObjectOpen,
+	Level_ObjectComma,
+	Level_ObjectName,
+	Level_ObjectColon,
+	Level_ObjectValue,
+	Level_ArrayOpen,
+	Level_ArrayComma,
+	Level_ArrayValue,
+	Level_Count,
+	Level_Dead = Level_Count,
+};
+
+// The state after a token other than a closing bracket, Level_Dead when the
+// token cannot come next. member is set for the values the container counts;
+// a nested container is counted when it opens.
+static inline
+unsigned stepLevel(unsigned state, TokenType tt, bool& member)
+{
+	member = false;
+	switch (tt) {
+	case TOKEN_COLON:
+		return (state == Level_ObjectName) ? Level_ObjectColon : Level_Dead;
+	case TOKEN_COMMA:
+		if (state == Level_ObjectValue) {
+			return Level_ObjectComma;
+		}else if (state == Level_ArrayValue) {
+			return Level_ArrayComma;
+		}
+		return Level_Dead;
+	default:
+		break;
+	}
+	switch (state) {
+	case Level_DocStart:
+		return (tt == TOKEN_LEFT_BRACE || tt == TOKEN_LEFT_BRACKET) ? Level_DocEnd : Level_Dead;
+	case Level_ObjectOpen:
+	case Level_ObjectComma:
+		return (tt == TOKEN_STRING) ? Level_ObjectName : Level_Dead;
+	case Level_ObjectColon:
+		member = true;
+		return Level_ObjectValue;
+	case Level_ArrayOpen:
+	case Level_ArrayComma:
+		member = true;
+		return Level_ArrayValue;
+	}
+	return Level_Dead;
+}
+
+static inline
+bool isObjectState(unsigned state)
+{
+	return state >= Level_ObjectOpen && state <= Level_ObjectValue;
+}
+
+static inline
+bool canClose(unsigned state, bool isObject)
+{
+	if (isObject) {
+		return state == Level_ObjectOpen || state == Level_ObjectValue;
+	}
+	return state == Level_ArrayOpen || state == Level_ArrayValue;
+}
+
+template <typename OffsetT>
+static inline
+bool writeContainer(OffsetT* tape, bool isObject, size_t count, size_t size)
+{
+	if (count > TapeLimits<OffsetT>::MaxCount || size > TapeLimits<OffsetT>::MaxSize) {
+		return false;
+	}
+	ContainerHeader<OffsetT> hdr;
+	hdr.isContainer = 1;
+	hdr.isObject = isObject;
+	hdr.count = (OffsetT)count;
+	hdr.size = (OffsetT)size;
+	*(ContainerHeader<OffsetT>*) tape = hdr;
+	return true;
+}
+
+// Tokens of a chunk on the level of a container that was opened in front of
+// the chunk, up to the bracket closing it or the end of the chunk.
+// The state that level is in when the chunk starts is not known yet, so the
+// tokens are run from every start state at once; stitching picks the one
+// the chunks in front end in.
+struct OuterSegment
+{
+	unsigned char endState[Level_Count];	// per start state, Level_Dead if impossible
+	size_t members[Level_Count];
+	size_t depth;			// deepest nesting of the containers opened in the segment
+	bool closes;			// ended by the bracket that closes the level
+	size_t closeSize;		// tape words of the chunk in front of that bracket
+};
+
+// The tape builder of one chunk. Containers opened and closed in the chunk
+// are checked and written like TapeBuilderT does; the rest is left in
+// segments (levels opened in front of the chunk) and levels (opened in the
+// chunk, closed behind it) for stitching.
+template <typename OffsetT>
+struct ChunkBuilderT
+{
+	enum {
+		MaxDepth = TapeBuilderT<OffsetT>::MaxDepth,
+		MaxSegments = MaxDepth + 2,
+		Strict = true,
+	};
+
+	struct Level
+	{
+		unsigned state;
+		size_t offset;		// of the container in the chunk tape
+		size_t members;
+	};
+
+	void Init(OffsetT* work, size_t capacity)
+	{
+		ErrorMessage = 0;
+		this->work = work;
+		this->capacity = capacity;
+		size = 0;
+		depth = 0;
+		segmentCount = 0;
+		beginSegment();
+	}
+
+	bool Token(TokenType tt, size_t position, size_t length, bool hasEscapes)
+	{
+		if (size + 2 > capacity) {
+			ErrorMessage = "chunk tape full";
+			return false;
+		}
+		bool isOpen = (tt == TOKEN_LEFT_BRACE || tt == TOKEN_LEFT_BRACKET);
+		if (tt == TOKEN_RIGHT_BRACE || tt == TOKEN_RIGHT_BRACKET) {
+			return close(tt == TOKEN_RIGHT_BRACE);
+		}
+		bool member;
+		if (depth == 0) {
+			OuterSegment& seg = segments[segmentCount - 1];
+			bool alive = false;
+			for (size_t s=0; s<Level_Count; ++s) {
+				if (seg.endState[s] == Level_Dead) {
+					continue;
+				}
+				seg.endState[s] = (unsigned char) stepLevel(seg.endState[s], tt, member);
+				if (seg.endState[s] != Level_Dead) {
+					alive = true;
+					seg.members[s] += member;
+				}
+			}
+			if (!alive) {
+				ErrorMessage = "token in invalid position";
+				return false;
+			}
+		}else {
+			Level& level = levels[depth - 1];
+			level.state = stepLevel(level.state, tt, member);
+			if (level.state == Level_Dead) {
+				ErrorMessage = "token in invalid position";
+				return false;
+			}
+			level.members += member;
+		}
+		if (isOpen) {
+			if (depth == MaxDepth) {
+				ErrorMessage = "nesting too deep";
+				return false;
+			}
+			Level& child = levels[depth++];
+			child.state = (tt == TOKEN_LEFT_BRACE) ? Level_ObjectOpen : Level_ArrayOpen;
+			child.offset = size;
+			child.members = 0;
+			size += 2;
+			OuterSegment& seg = segments[segmentCount - 1];
+			if (depth > seg.depth) {
+				seg.depth = depth;
+			}
+		}else if (tt & TOKEN_VALUE) {
+			writeScalar(work + size, position, length, tokenToType(tt), tt == TOKEN_STRING && hasEscapes);
+			size += 2;
+		}
+		return true;
+	}
+
+	bool Finish()
+	{
+		return true;
+	}
+
+	const char* ErrorMessage;
+	OffsetT* work;
+	size_t capacity;
+	size_t size;
+	Level levels[MaxDepth];
+	size_t depth;
+	OuterSegment segments[MaxSegments];
+	size_t segmentCount;
+
+private:
+	void beginSegment()
+	{
+		OuterSegment& seg = segments[segmentCount++];
+		for (size_t s=0; s<Level_Count; ++s) {
+			seg.endState[s] = (unsigned char) s;
+			seg.members[s] = 0;
+		}
+		seg.depth = 0;
+		seg.closes = false;
+		seg.closeSize = 0;
+	}
+
+	bool close(bool isObject)
+	{
+		if (depth) {
+			Level& level = levels[--depth];
+			if (!canClose(level.state, isObject)
+				|| !writeContainer(work + level.offset, isObject, level.members, size - level.offset)
+			) {
+				ErrorMessage = "invalid container";
+				return false;
+			}
+			return true;
+		}
+		OuterSegment& seg = segments[segmentCount - 1];
+		bool alive = false;
+		for (size_t s=0; s<Level_Count; ++s) {
+			if (seg.endState[s] != Level_Dead && !canClose(seg.endState[s], isObject)) {
+				seg.endState[s] = Level_Dead;
+			}
+			alive |= (seg.endState[s] != Level_Dead);
+		}
+		// every segment but the last closes one level, which can happen
+		// at most MaxDepth times in a valid document
+		if (!alive || segmentCount == MaxSegments) {
+			ErrorMessage = "invalid container";
+			return false;
+		}
+		seg.closes = true;
+		seg.closeSize = size;
+		beginSegment();
+		return true;
+	}
+};
+
+template <typename OffsetT>
+struct ChunkTask
+{
+	const char* json;
+	size_t len;
+	size_t begin;
+	size_t end;
+	size_t quotes;
+	bool inString;
+	OffsetT* tape;		// in scratch
+	OffsetT* dst;		// in work
+	const char* ErrorMessage;
+	ChunkBuilderT<OffsetT> builder;
+};
+
+template <typename OffsetT>
+static
+void countQuotes(void* p)
+{
+	ChunkTask<OffsetT>& task = *(ChunkTask<OffsetT>*) p;
+	StructuralIndexer indexer(task.json, task.len);
+	indexer.Restrict(task.begin, task.end, false);
+	task.quotes = indexer.CountQuotes();
+}
+
+template <typename OffsetT>
+static
+void buildChunk(void* p)
+{
+	ChunkTask<OffsetT>& task = *(ChunkTask<OffsetT>*) p;
+	StructuralIndexer indexer(task.json, task.len);
+	indexer.Restrict(task.begin, task.end, task.inString);
+	size_t errorOffset;
+	task.ErrorMessage = feedTokens(task.json, task.len, indexer, task.builder, errorOffset);
+}
+
+template <typename OffsetT>
+static
+void copyChunk(void* p)
+{
+	ChunkTask<OffsetT>& task = *(ChunkTask<OffsetT>*) p;
+	memcpy(task.dst, task.tape, task.builder.size * sizeof(OffsetT));
+}
+
+// runs func for every task, the calling thread takes the first one
+template <typename TaskT>
+static
+void runTasks(TaskT* tasks, size_t count, Thread::Func func)
+{
+	Thread threads[ParallelMaxChunks];
+	for (size_t i=1; i<count; ++i) {
+		if (!threads[i].Start(func, &tasks[i])) {
+			func(&tasks[i]);
+		}
+	}
+	func(&tasks[0]);
+	for (size_t i=1; i<count; ++i) {
+		threads[i].Join();
+	}
+}
+
+// A container level open at a chunk boundary
+struct OpenLevel
+{
+	unsigned state;
+	size_t chunk;		// the chunk it was opened in
+	size_t offset;		// in the tape of that chunk
+	size_t tapeOffset;	// in the whole tape
+	size_t members;
+};
+
+// Walks the chunks in order and resolves the levels each one left open.
+// Writes the headers of containers that cross a boundary into the chunk
+// tapes and sets where each chunk tape goes in the whole tape.
+template <typename OffsetT>
+static
+bool stitchChunks(ChunkTask<OffsetT>* tasks, size_t count, OffsetT* work)
+{
+	const size_t maxDepth = TapeBuilderT<OffsetT>::MaxDepth;
+	OpenLevel stack[maxDepth + 1];
+	stack[0].state = Level_DocStart;
+	stack[0].members = 0;
+	size_t n = 1;
+	size_t base = 0;
+	for (size_t c=0; c<count; ++c) {
+		const ChunkBuilderT<OffsetT>& b = tasks[c].builder;
+		for (size_t s=0; s<b.segmentCount; ++s) {
+			const OuterSegment& seg = b.segments[s];
+			OpenLevel& top = stack[n - 1];
+			unsigned state = seg.endState[top.state];
+			if (state == Level_Dead || (n - 1) + seg.depth > maxDepth) {
+				return false;
+			}
+			top.members += seg.members[top.state];
+			top.state = state;
+			if (!seg.closes) {
+				continue;
+			}
+			OffsetT* hdr = tasks[top.chunk].tape + top.offset;
+			if (!writeContainer(hdr, isObjectState(state), top.members, base + seg.closeSize - top.tapeOffset)) {
+				return false;
+			}
+			--n;
+		}
+		for (size_t i=0; i<b.depth; ++i) {
+			OpenLevel& level = stack[n++];
+			level.state = b.levels[i].state;
+			level.chunk = c;
+			level.offset = b.levels[i].offset;
+			level.tapeOffset = base + b.levels[i].offset;
+			level.members = b.levels[i].members;
+		}
+		tasks[c].dst = work + base;
+		base += b.size;
+	}
+	return n == 1 && stack[0].state == Level_DocEnd;
+}
+
+template <typename OffsetT>
+bool ParseChunked(const char* json, size_t len, OffsetT* work, TapeArenaT<OffsetT>& scratch, size_t chunkCount)
+{
+	const size_t blockSize = StructuralIndexer::BlockSize;
+	if (chunkCount > ParallelMaxChunks) {
+		chunkCount = ParallelMaxChunks;
+	}
+	if (chunkCount < 2 || len > TapeLimits<OffsetT>::MaxPosition) {
+		return false;
+	}
+	// chunks start on block boundaries
+	size_t chunkSize = (len + chunkCount - 1) / chunkCount;
+	chunkSize = (chunkSize + blockSize - 1) & ~(blockSize - 1);
+	chunkCount = (len + chunkSize - 1) / chunkSize;
+	if (chunkCount < 2) {
+		return false;
+	}
+
+	// each chunk tape has room for a word per byte, the containers opened
+	// in front of it and the string running over its end
+	const size_t slack = 2 * TapeBuilderT<OffsetT>::MaxDepth + 8;
+	scratch.Reset();
+	if (!scratch.Reserve(len + chunkCount * slack)) {
+		return false;
+	}
+	ChunkTask<OffsetT>* tasks = (ChunkTask<OffsetT>*) malloc(chunkCount * sizeof(ChunkTask<OffsetT>));
+	if (!tasks) {
+		return false;
+	}
+	for (size_t c=0; c<chunkCount; ++c) {
+		ChunkTask<OffsetT>& task = tasks[c];
+		task.json = json;
+		task.len = len;
+		task.begin = c * chunkSize;
+		task.end = (c == chunkCount - 1) ? len : task.begin + chunkSize;
+		size_t capacity = task.end - task.begin + slack;
+		task.tape = scratch.Allocate(capacity);
+		task.builder.Init(task.tape, capacity);
+		task.ErrorMessage = 0;
+	}
+
+	runTasks(tasks, chunkCount, countQuotes<OffsetT>);
+	size_t quotes = 0;
+	for (size_t c=0; c<chunkCount; ++c) {
+		tasks[c].inString = (quotes & 1) != 0;
+		quotes += tasks[c].quotes;
+	}
+
+	runTasks(tasks, chunkCount, buildChunk<OffsetT>);
+	bool ok = true;
+	for (size_t c=0; c<chunkCount; ++c) {
+		if (tasks[c].ErrorMessage) {
+			ok = false;
+			break;
+		}
+	}
+	if (ok) {
+		ok = stitchChunks(tasks, chunkCount, work);
+	}
+	if (ok) {
+		runTasks(tasks, chunkCount, copyChunk<OffsetT>);
+	}
+	free(tasks);
+	return ok;
+}
+
+template bool ParseChunked(const char* json, size_t len, uint16_t* work, TapeArenaT<uint16_t>& scratch, size_t chunkCount);
+template bool ParseChunked(const char* json, size_t len, uint32_t* work, TapeArenaT<uint32_t>& scratch, size_t chunkCount);
+
+} // namespace json16
+
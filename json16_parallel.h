@@ -0,0 +1,25 @@
+#pragma once
+
+#include "json16.h"
+#include "json16_context.h"
+
+namespace json16 {
+
+enum {
+	ParallelMaxChunks = 64,
+	ParallelMinChunkSize = 1 << 19,	// smallest chunk when the count is picked automatically
+};
+
+// Builds the tape of json on chunkCount threads, one chunk of the input each.
+// The quotes are counted first so that every chunk knows whether it starts
+// inside a string; then each thread indexes its chunk and writes a partial
+// tape into scratch. Containers that cross a chunk boundary get their count
+// and size when the partial tapes are stitched, after which the parts are
+// copied to work, which needs TapeSizeBound(len) words.
+// Returns false without a usable tape when the document has to go through
+// the serial parser instead, which includes every invalid document.
+template <typename OffsetT>
+bool ParseChunked(const char* json, size_t len, OffsetT* work, TapeArenaT<OffsetT>& scratch, size_t chunkCount);
+
+} // namespace json16
+
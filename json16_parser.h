@@ -0,0 +1,91 @@
+#pragma once
+
+// Member templates of ParserT.
+// json16.cpp instantiates ParserT with the default and the trusted policy
+// for both offset widths; include this header to instantiate another one:
+//
+//	template struct json16::ParserT<uint32_t, json16::ParserPolicy<64, true> >;
+
+#include "json16.h"
+#include "json16_tape.h"
+#include "json16_builder.h"
+#include "json16_number.h"
+
+namespace json16 {
+
+template <typename OffsetT, typename PolicyT>
+ParserT<OffsetT, PolicyT>::ParserT(const char* json, size_t len, OffsetT* work, const SideIndexT<OffsetT>* sideIndex)
+	:
+	ErrorMessage(0),
+	ErrorOffset(0),
+	json(json),
+	work(work),
+	index(0)
+{
+	if (len > TapeLimits<OffsetT>::MaxPosition) {
+		ErrorMessage = "document too large for tape offset width";
+		return;
+	}
+	StructuralIndexer indexer(json, len);
+	if (!PolicyT::Strict) {
+		indexer.SkipUtf8Check();
+	}
+	TapeBuilderT<OffsetT, true, PolicyT::MaxDepth, PolicyT::Strict> builder(work, TapeSizeBound(len, PolicyT::MaxDepth));
+	ErrorMessage = feedTokens(json, len, indexer, builder, ErrorOffset);
+	if (ErrorMessage) {
+		return;
+	}
+	if (sideIndex) {
+		if (!BuildSideIndex(json, (const OffsetT*)work, *sideIndex)) {
+			ErrorMessage = "side index capacity too small";
+			return;
+		}
+		index = sideIndex->memory;
+	}
+}
+
+template <typename OffsetT, typename PolicyT>
+ParserT<OffsetT, PolicyT>::ParserT(const char* json, const OffsetT* tape, const OffsetT* index)
+	:
+	ErrorMessage(0),
+	ErrorOffset(0),
+	json(json),
+	work(tape),
+	index(index)
+{
+}
+
+template <typename OffsetT, typename PolicyT>
+Type ParserT<OffsetT, PolicyT>::GetValueType() const
+{
+	return getValueType(work);
+}
+
+template <typename OffsetT, typename PolicyT>
+const char* ParserT<OffsetT, PolicyT>::GetString() const
+{
+	return getString(work, json);
+}
+
+template <typename OffsetT, typename PolicyT>
+double ParserT<OffsetT, PolicyT>::GetNumber() const
+{
+	size_t len;
+	const char* p = getNumberText(work, json, len);
+	return ParseDouble(p, len);
+}
+
+template <typename OffsetT, typename PolicyT>
+ObjectReaderT<OffsetT> ParserT<OffsetT, PolicyT>::GetObject() const
+{
+	return ObjectReaderT<OffsetT>(0, json, work, index);
+}
+
+template <typename OffsetT, typename PolicyT>
+ArrayReaderT<OffsetT> ParserT<OffsetT, PolicyT>::GetArray() const
+{
+	return ArrayReaderT<OffsetT>(0, json, work, index);
+}
+
+} // namespace json16
+
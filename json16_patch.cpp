@@ -0,0 +1,1429 @@
+#include "json16_patch.h"
+#include "json16_tape.h"
+#include "json16_builder.h"
+#include "json16_indexer.h"
+#include "json16_number.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace json16 {
+
+static const size_t NoNode = (size_t)-1;
+
+// A value that is still on the tape of the document (doc 0) or the patch
+// (doc 1) and its source bytes [begin, end).
+struct PatchSpan
+{
+	size_t doc;
+	size_t entry;
+	size_t begin;
+	size_t end;
+};
+
+// An entry of a rebuilt container: a run of members of the container it was
+// built from, unchanged, or a single member.
+struct PatchItem
+{
+	size_t node;		// NoNode for a run
+	// run : tape entries [first, last) of the origin, elements [index, index + count) of an array
+	size_t first;
+	size_t last;
+	size_t index;
+	size_t count;
+	// name of a single member : a name entry on a tape or decoded bytes in names
+	size_t nameDoc;
+	size_t nameEntry;	// NoNode for decoded bytes
+	size_t nameOffset;
+	size_t nameLength;
+};
+
+enum PatchNodeKind {
+	Node_span,			// a value on a tape
+	Node_container,		// a rebuilt container
+};
+
+struct PatchNode
+{
+	PatchNodeKind kind;
+	PatchSpan span;		// Node_container : the origin, doc NoNode for a new container
+	bool isObject;
+	PatchItem* items;
+	size_t itemCount;
+	size_t itemCapacity;
+};
+
+// where a member was found in a rebuilt container
+struct PatchLoc
+{
+	size_t at;			// item
+	size_t entry;		// name entry of an object member, entry of an array element, NoNode for a single item
+	size_t local;		// element number within the run
+};
+
+// array index token, no sign and no leading zeros
+static
+bool parseIndex(const char* p, size_t len, size_t& index)
+{
+	if (len == 0 || (len > 1 && p[0] == '0')) {
+		return false;
+	}
+	index = 0;
+	for (size_t i=0; i<len; ++i) {
+		size_t d = (size_t)(p[i] - '0');
+		if (d >= 10 || index > ((size_t)-1 - d) / 10) {
+			return false;
+		}
+		index = index * 10 + d;
+	}
+	return true;
+}
+
+// Reads the reference token at p (on its '/') and decodes ~0 and ~1 in place.
+static
+bool nextToken(char*& p, char* end, const char*& token, size_t& tokenLength)
+{
+	if (p == end) {
+		return false;
+	}
+	char* src = ++p;
+	char* dst = p;
+	while (src != end && *src != '/') {
+		if (*src == '~' && src + 1 != end && (src[1] == '0' || src[1] == '1')) {
+			*dst++ = (src[1] == '0') ? '~' : '/';
+			src += 2;
+		}else {
+			*dst++ = *src++;
+		}
+	}
+	token = p;
+	tokenLength = dst - p;
+	p = src;
+	return true;
+}
+
+static
+bool equalStrings(const StringRef& a, const StringRef& b)
+{
+	if (!a.hasEscapes && !b.hasEscapes) {
+		return a.length == b.length && memcmp(a.ptr, b.ptr, a.length) == 0;
+	}
+	char* buff = (char*) malloc(a.length + b.length + 1);
+	if (!buff) {
+		return false;
+	}
+	size_t lenA = Unescape(a, buff);
+	size_t lenB = Unescape(b, buff + lenA);
+	bool equal = (lenA == lenB && memcmp(buff, buff + lenA, lenA) == 0);
+	free(buff);
+	return equal;
+}
+
+// 1, 1.0 and 10e-1 are the same number
+static
+bool equalNumbers(const char* a, size_t lenA, const char* b, size_t lenB)
+{
+	int64_t x, y;
+	if (ParseInt64(a, lenA, x) && ParseInt64(b, lenB, y)) {
+		return x == y;
+	}
+	return ParseDouble(a, lenA) == ParseDouble(b, lenB);
+}
+
+template <typename OffsetT>
+PatcherT<OffsetT>::PatcherT(const char* json, size_t len, const OffsetT* tape, const OffsetT* index)
+	:
+	ErrorMessage(0),
+	ErrorOperation(0),
+	nodes(0),
+	nodeCount(0),
+	nodeCapacity(0),
+	root(NoNode),
+	names(0),
+	namesUsed(0),
+	namesCapacity(0),
+	buff(0),
+	buffCapacity(0),
+	keyBuff(0),
+	keyCapacity(0),
+	sink(0),
+	outTape(0),
+	outPos(0),
+	tooLarge(false)
+{
+	docs[0].json = json;
+	docs[0].len = len;
+	docs[0].tape = tape;
+	docs[0].index = index;
+	docs[1] = docs[0];
+}
+
+template <typename OffsetT>
+PatcherT<OffsetT>::~PatcherT()
+{
+	reset();
+	free(nodes);
+	free(names);
+	free(buff);
+	free(keyBuff);
+}
+
+template <typename OffsetT>
+void PatcherT<OffsetT>::reset()
+{
+	for (size_t i=0; i<nodeCount; ++i) {
+		free(nodes[i].items);
+	}
+	nodeCount = 0;
+	namesUsed = 0;
+	root = NoNode;
+	ErrorMessage = 0;
+	ErrorOperation = 0;
+}
+
+template <typename OffsetT>
+void PatcherT<OffsetT>::rootSpan(size_t doc, PatchSpan& span) const
+{
+	const Doc& d = docs[doc];
+	span.doc = doc;
+	span.entry = 0;
+	span.begin = skipSpace(d.json, d.len, 0);
+	span.end = skipSpaceBack(d.json, d.len);
+}
+
+// parses the patch and starts the overlay with the document as it is
+template <typename OffsetT>
+bool PatcherT<OffsetT>::begin(const char* patch, size_t len)
+{
+	reset();
+	size_t words = TapeSizeBound(len);
+	patchTape.Reset();
+	OffsetT* work = patchTape.Allocate(words);
+	if (!work) {
+		ErrorMessage = "out of memory";
+		return false;
+	}
+	ParserT<OffsetT> parser(patch, len, work);
+	if (parser.ErrorMessage) {
+		ErrorMessage = parser.ErrorMessage;
+		return false;
+	}
+	docs[1].json = patch;
+	docs[1].len = len;
+	docs[1].tape = work;
+	docs[1].index = 0;
+	PatchSpan span;
+	rootSpan(0, span);
+	root = newSpanNode(span);
+	return root != NoNode;
+}
+
+template <typename OffsetT>
+size_t PatcherT<OffsetT>::newNode()
+{
+	if (nodeCount == nodeCapacity) {
+		size_t capacity = nodeCapacity ? nodeCapacity * 2 : 64;
+		PatchNode* p = (PatchNode*) realloc(nodes, capacity * sizeof(PatchNode));
+		if (!p) {
+			ErrorMessage = "out of memory";
+			return NoNode;
+		}
+		nodes = p;
+		nodeCapacity = capacity;
+	}
+	PatchNode& n = nodes[nodeCount];
+	memset(&n, 0, sizeof(n));
+	n.span.doc = NoNode;
+	return nodeCount++;
+}
+
+template <typename OffsetT>
+size_t PatcherT<OffsetT>::newSpanNode(const PatchSpan& span)
+{
+	size_t n = newNode();
+	if (n != NoNode) {
+		nodes[n].kind = Node_span;
+		nodes[n].span = span;
+	}
+	return n;
+}
+
+template <typename OffsetT>
+size_t PatcherT<OffsetT>::newContainerNode(bool isObject)
+{
+	size_t n = newNode();
+	if (n != NoNode) {
+		nodes[n].kind = Node_container;
+		nodes[n].isObject = isObject;
+	}
+	return n;
+}
+
+// Turns a container on a tape into a rebuilt one holding a single run.
+template <typename OffsetT>
+bool PatcherT<OffsetT>::materialize(size_t node)
+{
+	PatchNode& n = nodes[node];
+	if (n.kind == Node_container) {
+		return true;
+	}
+	const OffsetT* entry = &docs[n.span.doc].tape[n.span.entry];
+	if (!isContainerEntry(entry)) {
+		ErrorMessage = "path not found";
+		return false;
+	}
+	n.kind = Node_container;
+	n.isObject = isObjectEntry(entry);
+	size_t count = getCount(*entry);
+	if (count == 0) {
+		return true;
+	}
+	PatchItem run = PatchItem();
+	run.node = NoNode;
+	run.first = n.span.entry + 2;
+	run.last = n.span.entry + entrySize(entry);
+	run.index = 0;
+	run.count = count;
+	return replaceItems(node, 0, 0, &run, 1);
+}
+
+// A single item becomes an empty object in place, for merge patch.
+template <typename OffsetT>
+void PatcherT<OffsetT>::makeEmptyObject(size_t node)
+{
+	PatchNode& n = nodes[node];
+	n.kind = Node_container;
+	n.isObject = true;
+	n.span.doc = NoNode;
+	n.itemCount = 0;
+}
+
+// replaces items [at, at + removeCount) of node with with[0, n)
+template <typename OffsetT>
+bool PatcherT<OffsetT>::replaceItems(size_t node, size_t at, size_t removeCount, const PatchItem* with, size_t n)
+{
+	PatchNode& c = nodes[node];
+	size_t count = c.itemCount - removeCount + n;
+	if (count > c.itemCapacity) {
+		size_t capacity = c.itemCapacity ? c.itemCapacity * 2 : 4;
+		if (capacity < count) {
+			capacity = count;
+		}
+		PatchItem* p = (PatchItem*) realloc(c.items, capacity * sizeof(PatchItem));
+		if (!p) {
+			ErrorMessage = "out of memory";
+			return false;
+		}
+		c.items = p;
+		c.itemCapacity = capacity;
+	}
+	if (c.itemCount - at - removeCount) {
+		memmove(c.items + at + n, c.items + at + removeCount, (c.itemCount - at - removeCount) * sizeof(PatchItem));
+	}
+	if (n) {
+		memcpy(c.items + at, with, n * sizeof(PatchItem));
+	}
+	c.itemCount = count;
+	return true;
+}
+
+// Replaces the entries [cutBegin, cutEnd) of the run at with mid, when given.
+// localBegin and localEnd are the element numbers of the cut within the run.
+template <typename OffsetT>
+bool PatcherT<OffsetT>::splitRun(size_t node, size_t at, size_t cutBegin, size_t cutEnd, size_t localBegin, size_t localEnd, const PatchItem* mid)
+{
+	PatchItem run = nodes[node].items[at];
+	PatchItem parts[3];
+	size_t n = 0;
+	if (cutBegin > run.first) {
+		parts[n] = run;
+		parts[n].last = cutBegin;
+		parts[n].count = localBegin;
+		++n;
+	}
+	if (mid) {
+		parts[n++] = *mid;
+	}
+	if (cutEnd < run.last) {
+		parts[n] = run;
+		parts[n].first = cutEnd;
+		parts[n].index = run.index + localEnd;
+		parts[n].count = run.count - localEnd;
+		++n;
+	}
+	return replaceItems(node, at, 1, parts, n);
+}
+
+template <typename OffsetT>
+bool PatcherT<OffsetT>::appendMember(size_t node, size_t nameDoc, size_t nameEntry, size_t value)
+{
+	PatchItem item = PatchItem();
+	item.node = value;
+	item.nameDoc = nameDoc;
+	item.nameEntry = nameEntry;
+	return replaceItems(node, nodes[node].itemCount, 0, &item, 1);
+}
+
+// deep copy, a node may only be in one place
+template <typename OffsetT>
+size_t PatcherT<OffsetT>::cloneNode(size_t node)
+{
+	size_t n = newNode();
+	if (n == NoNode) {
+		return NoNode;
+	}
+	nodes[n] = nodes[node];
+	nodes[n].items = 0;
+	nodes[n].itemCount = 0;
+	nodes[n].itemCapacity = 0;
+	if (nodes[node].kind == Node_span || nodes[node].itemCount == 0) {
+		return n;
+	}
+	if (!replaceItems(n, 0, 0, nodes[node].items, nodes[node].itemCount)) {
+		return NoNode;
+	}
+	for (size_t i=0; i<nodes[n].itemCount; ++i) {
+		size_t child = nodes[n].items[i].node;
+		if (child != NoNode) {
+			child = cloneNode(child);
+			if (child == NoNode) {
+				return NoNode;
+			}
+			nodes[n].items[i].node = child;
+		}
+	}
+	return n;
+}
+
+template <typename OffsetT>
+bool PatcherT<OffsetT>::isObjectNode(size_t node) const
+{
+	const PatchNode& n = nodes[node];
+	if (n.kind == Node_container) {
+		return n.isObject;
+	}
+	return isObjectEntry(&docs[n.span.doc].tape[n.span.entry]);
+}
+
+// members an item stands for
+template <typename OffsetT>
+size_t PatcherT<OffsetT>::memberCount(size_t node, const PatchItem& item) const
+{
+	if (item.node != NoNode) {
+		return 1;
+	}
+	if (!nodes[node].isObject) {
+		return item.count;
+	}
+	// runs of objects do not keep their count, lookups go through the names
+	const OffsetT* tape = docs[nodes[node].span.doc].tape;
+	size_t count = 0;
+	for (size_t e=item.first; e<item.last; e+=entrySize(&tape[e])) {
+		e += 2;
+		++count;
+	}
+	return count;
+}
+
+template <typename OffsetT>
+size_t PatcherT<OffsetT>::elementCount(size_t node) const
+{
+	const PatchNode& n = nodes[node];
+	size_t count = 0;
+	for (size_t i=0; i<n.itemCount; ++i) {
+		count += memberCount(node, n.items[i]);
+	}
+	return count;
+}
+
+// Start of member x of container, x being the name entry of an object member
+// or the entry of an array element.
+template <typename OffsetT>
+size_t PatcherT<OffsetT>::memberStart(const PatchSpan& container, size_t x) const
+{
+	const Doc& d = docs[container.doc];
+	if (isObjectEntry(&d.tape[container.entry])) {
+		return entryPosition(&d.tape[x]);
+	}
+	return valueStart(container, x);
+}
+
+// Start of the value at entry v of container, see findContainerStart.
+template <typename OffsetT>
+size_t PatcherT<OffsetT>::valueStart(const PatchSpan& container, size_t v) const
+{
+	const Doc& d = docs[container.doc];
+	const OffsetT* tape = d.tape;
+	if (isObjectEntry(&tape[container.entry])) {
+		// after the name and the colon
+		size_t p = entryPosition(&tape[v - 2]) + getTokenLength(&tape[v - 2], d.json);
+		p = skipSpace(d.json, d.len, p);
+		return skipSpace(d.json, d.len, p + 1);
+	}
+	if (!isContainerEntry(&tape[v])) {
+		return entryPosition(&tape[v]);
+	}
+	size_t p;
+	if (findContainerStart(d.json, tape, v, p)) {
+		return p;
+	}
+	// nothing but empty containers inside, step over the elements in front
+	p = container.begin + 1;
+	for (size_t x=container.entry+2; ; x+=entrySize(&tape[x])) {
+		p = skipSpace(d.json, d.len, p);
+		if (x == v) {
+			return p;
+		}
+		if (isContainerEntry(&tape[x])) {
+			p = FindContainerEnd(d.json, d.len, p);
+		}else {
+			p += getTokenLength(&tape[x], d.json);
+		}
+		p = skipSpace(d.json, d.len, p) + 1;
+	}
+}
+
+// end of the member in front of x, x being a member entry of container or its end
+template <typename OffsetT>
+size_t PatcherT<OffsetT>::memberEndBefore(const PatchSpan& container, size_t x) const
+{
+	const Doc& d = docs[container.doc];
+	if (x == container.entry + entrySize(&d.tape[container.entry])) {
+		// in front of the closing bracket
+		return skipSpaceBack(d.json, container.end - 1);
+	}
+	size_t p = skipSpaceBack(d.json, memberStart(container, x));
+	// and the comma
+	return skipSpaceBack(d.json, p - 1);
+}
+
+template <typename OffsetT>
+void PatcherT<OffsetT>::childSpan(const PatchSpan& container, size_t v, PatchSpan& span) const
+{
+	const Doc& d = docs[container.doc];
+	const OffsetT* entry = &d.tape[v];
+	span.doc = container.doc;
+	span.entry = v;
+	span.begin = valueStart(container, v);
+	if (isContainerEntry(entry)) {
+		span.end = memberEndBefore(container, v + entrySize(entry));
+	}else {
+		span.end = span.begin + getTokenLength(entry, d.json);
+	}
+}
+
+template <typename OffsetT>
+bool PatcherT<OffsetT>::findMember(size_t node, const char* key, size_t len, PatchLoc& loc)
+{
+	const PatchNode& n = nodes[node];
+	bool hasRun = false;
+	for (size_t i=0; i<n.itemCount; ++i) {
+		const PatchItem& item = n.items[i];
+		if (item.node == NoNode) {
+			hasRun = true;
+			continue;
+		}
+		bool equal;
+		if (item.nameEntry != NoNode) {
+			const Doc& d = docs[item.nameDoc];
+			equal = nameEquals(getStringRef(&d.tape[item.nameEntry], d.json), key, len);
+		}else {
+			// names stays unallocated while every added name is empty
+			equal = (item.nameLength == len && (len == 0 || memcmp(names + item.nameOffset, key, len) == 0));
+		}
+		if (equal) {
+			loc.at = i;
+			loc.entry = NoNode;
+			loc.local = 0;
+			return true;
+		}
+	}
+	if (!hasRun) {
+		return false;
+	}
+	// the runs are parts of the origin, which is looked up as a whole
+	const Doc& d = docs[n.span.doc];
+	ObjectReaderT<OffsetT> reader((OffsetT)n.span.entry, d.json, d.tape, d.index);
+	if (!reader.Find(key, len)) {
+		return false;
+	}
+	size_t name = reader.GetReadOffset() - 2;
+	for (size_t i=0; i<n.itemCount; ++i) {
+		const PatchItem& item = n.items[i];
+		if (item.node == NoNode && item.first <= name && name < item.last) {
+			loc.at = i;
+			loc.entry = name;
+			loc.local = 0;
+			return true;
+		}
+	}
+	// removed or replaced
+	return false;
+}
+
+template <typename OffsetT>
+bool PatcherT<OffsetT>::findElement(size_t node, size_t index, PatchLoc& loc)
+{
+	const PatchNode& n = nodes[node];
+	for (size_t i=0; i<n.itemCount; ++i) {
+		const PatchItem& item = n.items[i];
+		if (item.node != NoNode) {
+			if (index == 0) {
+				loc.at = i;
+				loc.entry = NoNode;
+				loc.local = 0;
+				return true;
+			}
+			--index;
+		}else if (index < item.count) {
+			const Doc& d = docs[n.span.doc];
+			ArrayReaderT<OffsetT> reader((OffsetT)n.span.entry, d.json, d.tape, d.index);
+			reader.At(item.index + index);
+			loc.at = i;
+			loc.entry = reader.GetReadOffset();
+			loc.local = index;
+			return true;
+		}else {
+			index -= item.count;
+		}
+	}
+	return false;
+}
+
+// finds the member the reference token names in the rebuilt container node
+template <typename OffsetT>
+bool PatcherT<OffsetT>::locate(size_t node, const char* token, size_t len, PatchLoc& loc)
+{
+	if (nodes[node].isObject) {
+		if (!findMember(node, token, len, loc)) {
+			ErrorMessage = "path not found";
+			return false;
+		}
+		return true;
+	}
+	size_t index;
+	if (!parseIndex(token, len, index)) {
+		ErrorMessage = "invalid array index";
+		return false;
+	}
+	if (!findElement(node, index, loc)) {
+		ErrorMessage = "array index out of range";
+		return false;
+	}
+	return true;
+}
+
+// The node of the member at loc. A member of a run becomes a single item.
+template <typename OffsetT>
+size_t PatcherT<OffsetT>::extract(size_t node, const PatchLoc& loc)
+{
+	if (loc.entry == NoNode) {
+		return nodes[node].items[loc.at].node;
+	}
+	PatchSpan origin = nodes[node].span;
+	bool isObject = nodes[node].isObject;
+	size_t v = isObject ? loc.entry + 2 : loc.entry;
+	PatchSpan span;
+	childSpan(origin, v, span);
+	size_t child = newSpanNode(span);
+	if (child == NoNode) {
+		return NoNode;
+	}
+	PatchItem item = PatchItem();
+	item.node = child;
+	item.nameDoc = origin.doc;
+	item.nameEntry = isObject ? loc.entry : NoNode;
+	if (!splitRun(node, loc.at, loc.entry, v + entrySize(&docs[origin.doc].tape[v]), loc.local, loc.local + 1, &item)) {
+		return NoNode;
+	}
+	return child;
+}
+
+// puts value in place of the member at loc, keeping its name
+template <typename OffsetT>
+bool PatcherT<OffsetT>::setAt(size_t node, const PatchLoc& loc, size_t value)
+{
+	if (loc.entry == NoNode) {
+		nodes[node].items[loc.at].node = value;
+		return true;
+	}
+	size_t doc = nodes[node].span.doc;
+	bool isObject = nodes[node].isObject;
+	size_t v = isObject ? loc.entry + 2 : loc.entry;
+	PatchItem item = PatchItem();
+	item.node = value;
+	item.nameDoc = doc;
+	item.nameEntry = isObject ? loc.entry : NoNode;
+	return splitRun(node, loc.at, loc.entry, v + entrySize(&docs[doc].tape[v]), loc.local, loc.local + 1, &item);
+}
+
+template <typename OffsetT>
+bool PatcherT<OffsetT>::removeAt(size_t node, const PatchLoc& loc)
+{
+	if (loc.entry == NoNode) {
+		return replaceItems(node, loc.at, 1, 0, 0);
+	}
+	size_t doc = nodes[node].span.doc;
+	size_t v = nodes[node].isObject ? loc.entry + 2 : loc.entry;
+	return splitRun(node, loc.at, loc.entry, v + entrySize(&docs[doc].tape[v]), loc.local, loc.local + 1, 0);
+}
+
+// Rebuilds the containers path leads through and returns the one its last
+// reference token refers into.
+template <typename OffsetT>
+size_t PatcherT<OffsetT>::resolveParent(char* path, char* end, const char*& last, size_t& lastLength)
+{
+	size_t node = root;
+	char* p = path;
+	nextToken(p, end, last, lastLength);
+	while (p != end) {
+		if (!materialize(node)) {
+			return NoNode;
+		}
+		PatchLoc loc;
+		if (!locate(node, last, lastLength, loc)) {
+			return NoNode;
+		}
+		node = extract(node, loc);
+		if (node == NoNode) {
+			return NoNode;
+		}
+		nextToken(p, end, last, lastLength);
+	}
+	if (!materialize(node)) {
+		return NoNode;
+	}
+	return node;
+}
+
+// The value path refers to, without rebuilding anything: a rebuilt
+// container in node, or a value on a tape in span with node NoNode.
+template <typename OffsetT>
+bool PatcherT<OffsetT>::resolveValue(char* path, char* end, size_t& node, PatchSpan& span)
+{
+	node = root;
+	if (nodes[node].kind == Node_span) {
+		span = nodes[node].span;
+		node = NoNode;
+	}
+	const char* token;
+	size_t len;
+	char* p = path;
+	while (nextToken(p, end, token, len)) {
+		if (node != NoNode) {
+			PatchLoc loc;
+			if (!locate(node, token, len, loc)) {
+				return false;
+			}
+			if (loc.entry == NoNode) {
+				node = nodes[node].items[loc.at].node;
+				if (nodes[node].kind == Node_span) {
+					span = nodes[node].span;
+					node = NoNode;
+				}
+			}else {
+				PatchSpan origin = nodes[node].span;
+				childSpan(origin, nodes[node].isObject ? loc.entry + 2 : loc.entry, span);
+				node = NoNode;
+			}
+			continue;
+		}
+		const Doc& d = docs[span.doc];
+		const OffsetT* entry = &d.tape[span.entry];
+		if (!isContainerEntry(entry)) {
+			ErrorMessage = "path not found";
+			return false;
+		}
+		size_t v;
+		if (isObjectEntry(entry)) {
+			ObjectReaderT<OffsetT> reader((OffsetT)span.entry, d.json, d.tape, d.index);
+			if (!reader.Find(token, len)) {
+				ErrorMessage = "path not found";
+				return false;
+			}
+			v = reader.GetReadOffset();
+		}else {
+			size_t index;
+			if (!parseIndex(token, len, index)) {
+				ErrorMessage = "invalid array index";
+				return false;
+			}
+			ArrayReaderT<OffsetT> reader((OffsetT)span.entry, d.json, d.tape, d.index);
+			if (!reader.At(index)) {
+				ErrorMessage = "array index out of range";
+				return false;
+			}
+			v = reader.GetReadOffset();
+		}
+		PatchSpan container = span;
+		childSpan(container, v, span);
+	}
+	return true;
+}
+
+// the name without escapes, in keyBuff when it has some
+template <typename OffsetT>
+const char* PatcherT<OffsetT>::unescapeKey(const StringRef& name, size_t& len)
+{
+	if (!name.hasEscapes) {
+		len = name.length;
+		return name.ptr;
+	}
+	if (name.length > keyCapacity) {
+		char* p = (char*) realloc(keyBuff, name.length);
+		if (!p) {
+			ErrorMessage = "out of memory";
+			return 0;
+		}
+		keyBuff = p;
+		keyCapacity = name.length;
+	}
+	len = Unescape(name, keyBuff);
+	return keyBuff;
+}
+
+// the root stays a container, a tape cannot hold anything else
+template <typename OffsetT>
+bool PatcherT<OffsetT>::setRoot(size_t value)
+{
+	const PatchNode& n = nodes[value];
+	if (n.kind == Node_span && !isContainerEntry(&docs[n.span.doc].tape[n.span.entry])) {
+		ErrorMessage = "root is not an object or array";
+		return false;
+	}
+	root = value;
+	return true;
+}
+
+template <typename OffsetT>
+bool PatcherT<OffsetT>::add(char* path, char* end, size_t value)
+{
+	if (path == end) {
+		return setRoot(value);
+	}
+	const char* token;
+	size_t len;
+	size_t node = resolveParent(path, end, token, len);
+	if (node == NoNode) {
+		return false;
+	}
+	PatchLoc loc;
+	PatchItem item = PatchItem();
+	item.node = value;
+	item.nameEntry = NoNode;
+	if (nodes[node].isObject) {
+		if (findMember(node, token, len, loc)) {
+			return setAt(node, loc, value);
+		}
+		// a new member goes last, with the name decoded from the path
+		if (len > namesCapacity - namesUsed) {
+			size_t capacity = namesCapacity ? namesCapacity * 2 : 256;
+			while (capacity - namesUsed < len) {
+				capacity *= 2;
+			}
+			char* p = (char*) realloc(names, capacity);
+			if (!p) {
+				ErrorMessage = "out of memory";
+				return false;
+			}
+			names = p;
+			namesCapacity = capacity;
+		}
+		if (len) {
+			memcpy(names + namesUsed, token, len);
+		}
+		item.nameOffset = namesUsed;
+		item.nameLength = len;
+		namesUsed += len;
+		return replaceItems(node, nodes[node].itemCount, 0, &item, 1);
+	}
+	size_t count = elementCount(node);
+	size_t index;
+	if (len == 1 && token[0] == '-') {
+		index = count;
+	}else if (!parseIndex(token, len, index)) {
+		ErrorMessage = "invalid array index";
+		return false;
+	}
+	if (index > count) {
+		ErrorMessage = "array index out of range";
+		return false;
+	}
+	if (index == count) {
+		return replaceItems(node, nodes[node].itemCount, 0, &item, 1);
+	}
+	findElement(node, index, loc);
+	if (loc.entry == NoNode || loc.local == 0) {
+		return replaceItems(node, loc.at, 0, &item, 1);
+	}
+	// cut the run in front of the element
+	return splitRun(node, loc.at, loc.entry, loc.entry, loc.local, loc.local, &item);
+}
+
+// removed, when given, receives the node of the value, for move
+template <typename OffsetT>
+bool PatcherT<OffsetT>::remove(char* path, char* end, size_t* removed)
+{
+	if (path == end) {
+		ErrorMessage = "root cannot be removed";
+		return false;
+	}
+	const char* token;
+	size_t len;
+	size_t node = resolveParent(path, end, token, len);
+	if (node == NoNode) {
+		return false;
+	}
+	PatchLoc loc;
+	if (!locate(node, token, len, loc)) {
+		return false;
+	}
+	if (removed) {
+		*removed = extract(node, loc);
+		if (*removed == NoNode) {
+			return false;
+		}
+		if (loc.entry != NoNode) {
+			// it is a single item now
+			locate(node, token, len, loc);
+		}
+	}
+	return removeAt(node, loc);
+}
+
+template <typename OffsetT>
+bool PatcherT<OffsetT>::replace(char* path, char* end, size_t value)
+{
+	if (path == end) {
+		return setRoot(value);
+	}
+	const char* token;
+	size_t len;
+	size_t node = resolveParent(path, end, token, len);
+	if (node == NoNode) {
+		return false;
+	}
+	PatchLoc loc;
+	if (!locate(node, token, len, loc)) {
+		return false;
+	}
+	return setAt(node, loc, value);
+}
+
+// aNode is a node of the overlay or NoNode for the entry aEntry of aDoc
+template <typename OffsetT>
+bool PatcherT<OffsetT>::equalValues(size_t aNode, size_t aDoc, size_t aEntry, size_t bDoc, size_t bEntry)
+{
+	if (aNode != NoNode && nodes[aNode].kind == Node_span) {
+		aDoc = nodes[aNode].span.doc;
+		aEntry = nodes[aNode].span.entry;
+		aNode = NoNode;
+	}
+	if (aNode == NoNode) {
+		return equalEntries(aDoc, aEntry, bDoc, bEntry);
+	}
+	const Doc& b = docs[bDoc];
+	const OffsetT* entry = &b.tape[bEntry];
+	if (!isContainerEntry(entry) || isObjectEntry(entry) != nodes[aNode].isObject) {
+		return false;
+	}
+	size_t count = getCount(*entry);
+	if (elementCount(aNode) != count) {
+		return false;
+	}
+	size_t e = bEntry + 2;
+	if (nodes[aNode].isObject) {
+		for (size_t i=0; i<count; ++i) {
+			size_t len;
+			const char* key = unescapeKey(getStringRef(&b.tape[e], b.json), len);
+			PatchLoc loc;
+			if (!key || !findMember(aNode, key, len, loc)) {
+				return false;
+			}
+			e += 2;
+			if (loc.entry == NoNode) {
+				if (!equalValues(nodes[aNode].items[loc.at].node, 0, 0, bDoc, e)) {
+					return false;
+				}
+			}else if (!equalEntries(nodes[aNode].span.doc, loc.entry + 2, bDoc, e)) {
+				return false;
+			}
+			e += entrySize(&b.tape[e]);
+		}
+		return true;
+	}
+	for (size_t i=0; i<nodes[aNode].itemCount; ++i) {
+		PatchItem item = nodes[aNode].items[i];
+		if (item.node != NoNode) {
+			if (!equalValues(item.node, 0, 0, bDoc, e)) {
+				return false;
+			}
+			e += entrySize(&b.tape[e]);
+			continue;
+		}
+		size_t doc = nodes[aNode].span.doc;
+		for (size_t x=item.first; x<item.last; x+=entrySize(&docs[doc].tape[x])) {
+			if (!equalEntries(doc, x, bDoc, e)) {
+				return false;
+			}
+			e += entrySize(&b.tape[e]);
+		}
+	}
+	return true;
+}
+
+template <typename OffsetT>
+bool PatcherT<OffsetT>::equalEntries(size_t aDoc, size_t aEntry, size_t bDoc, size_t bEntry)
+{
+	const Doc& a = docs[aDoc];
+	const Doc& b = docs[bDoc];
+	const OffsetT* x = &a.tape[aEntry];
+	const OffsetT* y = &b.tape[bEntry];
+	Type type = getValueType(x);
+	if (type != getValueType(y)) {
+		return false;
+	}
+	switch (type) {
+	case Type_string:
+		return equalStrings(getStringRef(x, a.json), getStringRef(y, b.json));
+	case Type_number:
+		{
+			size_t lenA, lenB;
+			const char* p = getNumberText(x, a.json, lenA);
+			const char* q = getNumberText(y, b.json, lenB);
+			return equalNumbers(p, lenA, q, lenB);
+		}
+	case Type_object:
+	case Type_array:
+		break;
+	default:
+		return true;
+	}
+	size_t count = getCount(*x);
+	if (count != getCount(*y)) {
+		return false;
+	}
+	size_t e = bEntry + 2;
+	if (type == Type_array) {
+		size_t f = aEntry + 2;
+		for (size_t i=0; i<count; ++i) {
+			if (!equalEntries(aDoc, f, bDoc, e)) {
+				return false;
+			}
+			f += entrySize(&a.tape[f]);
+			e += entrySize(&b.tape[e]);
+		}
+		return true;
+	}
+	for (size_t i=0; i<count; ++i) {
+		size_t len;
+		const char* key = unescapeKey(getStringRef(&b.tape[e], b.json), len);
+		ObjectReaderT<OffsetT> reader((OffsetT)aEntry, a.json, a.tape, a.index);
+		if (!key || !reader.Find(key, len)) {
+			return false;
+		}
+		e += 2;
+		if (!equalEntries(aDoc, reader.GetReadOffset(), bDoc, e)) {
+			return false;
+		}
+		e += entrySize(&b.tape[e]);
+	}
+	return true;
+}
+
+// applies the operation object at entry op of the patch
+template <typename OffsetT>
+bool PatcherT<OffsetT>::apply(size_t op, const PatchSpan& opSpan)
+{
+	const Doc& d = docs[1];
+	if (!isObjectEntry(&d.tape[op])) {
+		ErrorMessage = "operation is not an object";
+		return false;
+	}
+	ObjectReaderT<OffsetT> reader((OffsetT)op, d.json, d.tape);
+	if (!reader.Find("op", 2) || reader.GetValueType() != Type_string) {
+		ErrorMessage = "operation without op";
+		return false;
+	}
+	StringRef name = reader.ReadStringRef();
+	enum { Op_add, Op_remove, Op_replace, Op_move, Op_copy, Op_test } kind;
+	if (nameEquals(name, "add", 3)) {
+		kind = Op_add;
+	}else if (nameEquals(name, "remove", 6)) {
+		kind = Op_remove;
+	}else if (nameEquals(name, "replace", 7)) {
+		kind = Op_replace;
+	}else if (nameEquals(name, "move", 4)) {
+		kind = Op_move;
+	}else if (nameEquals(name, "copy", 4)) {
+		kind = Op_copy;
+	}else if (nameEquals(name, "test", 4)) {
+		kind = Op_test;
+	}else {
+		ErrorMessage = "unknown op";
+		return false;
+	}
+	if (!reader.Find("path", 4) || reader.GetValueType() != Type_string) {
+		ErrorMessage = "operation without path";
+		return false;
+	}
+	StringRef pathRef = reader.ReadStringRef();
+	StringRef fromRef = StringRef();
+	if (kind == Op_move || kind == Op_copy) {
+		if (!reader.Find("from", 4) || reader.GetValueType() != Type_string) {
+			ErrorMessage = "operation without from";
+			return false;
+		}
+		fromRef = reader.ReadStringRef();
+	}
+	size_t value = NoNode;
+	size_t valueEntry = 0;
+	if (kind == Op_add || kind == Op_replace || kind == Op_test) {
+		if (!reader.Find("value", 5)) {
+			ErrorMessage = "operation without value";
+			return false;
+		}
+		valueEntry = reader.GetReadOffset();
+		if (kind != Op_test) {
+			PatchSpan span;
+			childSpan(opSpan, valueEntry, span);
+			value = newSpanNode(span);
+			if (value == NoNode) {
+				return false;
+			}
+		}
+	}
+
+	// unescaping never makes a string longer
+	size_t needed = pathRef.length + fromRef.length + 1;
+	if (needed > buffCapacity) {
+		char* p = (char*) realloc(buff, needed);
+		if (!p) {
+			ErrorMessage = "out of memory";
+			return false;
+		}
+		buff = p;
+		buffCapacity = needed;
+	}
+	char* path = buff;
+	char* pathEnd = path + Unescape(pathRef, path);
+	char* from = pathEnd;
+	char* fromEnd = from + (fromRef.ptr ? Unescape(fromRef, from) : 0);
+	if ((path != pathEnd && *path != '/') || (from != fromEnd && *from != '/')) {
+		ErrorMessage = "invalid path";
+		return false;
+	}
+
+	switch (kind) {
+	case Op_add:
+		return add(path, pathEnd, value);
+	case Op_remove:
+		return remove(path, pathEnd, 0);
+	case Op_replace:
+		return replace(path, pathEnd, value);
+	case Op_move:
+		{
+			size_t fromLen = fromEnd - from;
+			size_t pathLen = pathEnd - path;
+			if (fromLen == pathLen && memcmp(from, path, pathLen) == 0) {
+				// only has to exist
+				PatchSpan span;
+				return resolveValue(from, fromEnd, value, span);
+			}
+			if (fromLen < pathLen && memcmp(from, path, fromLen) == 0 && path[fromLen] == '/') {
+				ErrorMessage = "cannot move a value into itself";
+				return false;
+			}
+			return remove(from, fromEnd, &value) && add(path, pathEnd, value);
+		}
+	case Op_copy:
+		{
+			PatchSpan span;
+			size_t node;
+			if (!resolveValue(from, fromEnd, node, span)) {
+				return false;
+			}
+			value = (node != NoNode) ? cloneNode(node) : newSpanNode(span);
+			return value != NoNode && add(path, pathEnd, value);
+		}
+	case Op_test:
+		{
+			PatchSpan span;
+			size_t node;
+			if (!resolveValue(path, pathEnd, node, span)) {
+				return false;
+			}
+			bool equal = (node != NoNode) ? equalValues(node, 0, 0, 1, valueEntry) : equalEntries(span.doc, span.entry, 1, valueEntry);
+			if (!equal && !ErrorMessage) {
+				ErrorMessage = "test failed";
+			}
+			return equal;
+		}
+	}
+	return false;
+}
+
+// merges the object of the patch at patch into the rebuilt object node
+template <typename OffsetT>
+bool PatcherT<OffsetT>::mergeObject(size_t node, const PatchSpan& patch)
+{
+	const Doc& d = docs[1];
+	size_t count = getCount(d.tape[patch.entry]);
+	size_t e = patch.entry + 2;
+	for (size_t i=0; i<count; ++i, e+=entrySize(&d.tape[e])) {
+		size_t name = e;
+		e += 2;
+		size_t len;
+		const char* key = unescapeKey(getStringRef(&d.tape[name], d.json), len);
+		if (!key) {
+			return false;
+		}
+		PatchLoc loc;
+		bool found = findMember(node, key, len, loc);
+		Type type = getValueType(&d.tape[e]);
+		if (type == Type_null) {
+			if (found && !removeAt(node, loc)) {
+				return false;
+			}
+			continue;
+		}
+		PatchSpan span;
+		childSpan(patch, e, span);
+		if (type != Type_object) {
+			size_t value = newSpanNode(span);
+			if (value == NoNode || !(found ? setAt(node, loc, value) : appendMember(node, 1, name, value))) {
+				return false;
+			}
+			continue;
+		}
+		size_t child;
+		if (found) {
+			child = extract(node, loc);
+			if (child == NoNode) {
+				return false;
+			}
+			if (!isObjectNode(child)) {
+				makeEmptyObject(child);
+			}
+		}else {
+			child = newContainerNode(true);
+			if (child == NoNode || !appendMember(node, 1, name, child)) {
+				return false;
+			}
+		}
+		// done with key, the nested merge reuses keyBuff
+		if (!materialize(child) || !mergeObject(child, span)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Writes node and, with outTape, its tape.
+template <typename OffsetT>
+bool PatcherT<OffsetT>::writeNode(size_t node)
+{
+	if (nodes[node].kind == Node_span) {
+		PatchSpan span = nodes[node].span;
+		return writeRaw(span.doc, span.begin, span.end, span.entry, entrySize(&docs[span.doc].tape[span.entry]));
+	}
+	size_t header = 0;
+	if (outTape) {
+		header = outTape->GetUsed();
+		if (!outTape->Allocate(2)) {
+			ErrorMessage = "out of memory";
+			return false;
+		}
+	}
+	bool isObject = nodes[node].isObject;
+	sink->Put(isObject ? '{' : '[');
+	++outPos;
+	size_t count = 0;
+	for (size_t i=0; i<nodes[node].itemCount; ++i) {
+		if (i) {
+			sink->Put(',');
+			++outPos;
+		}
+		PatchItem item = nodes[node].items[i];
+		if (item.node == NoNode) {
+			PatchSpan origin = nodes[node].span;
+			size_t begin = memberStart(origin, item.first);
+			size_t end = memberEndBefore(origin, item.last);
+			if (!writeRaw(origin.doc, begin, end, item.first, item.last - item.first)) {
+				return false;
+			}
+			if (outTape) {
+				count += memberCount(node, item);
+			}
+			continue;
+		}
+		if (isObject) {
+			if (!writeName(item)) {
+				return false;
+			}
+			sink->Put(':');
+			++outPos;
+		}
+		if (!writeNode(item.node)) {
+			return false;
+		}
+		++count;
+	}
+	sink->Put(isObject ? '}' : ']');
+	++outPos;
+	if (outTape) {
+		size_t size = outTape->GetUsed() - header;
+		if (count > TapeLimits<OffsetT>::MaxCount || size > TapeLimits<OffsetT>::MaxSize) {
+			tooLarge = true;
+		}
+		ContainerHeader<OffsetT> ch;
+		ch.count = (OffsetT)count;
+		ch.isObject = isObject;
+		ch.isContainer = true;
+		ch.size = (OffsetT)size;
+		memcpy(outTape->GetMemory() + header, &ch, sizeof(ch));
+	}
+	return true;
+}
+
+template <typename OffsetT>
+bool PatcherT<OffsetT>::writeName(const PatchItem& item)
+{
+	if (item.nameEntry != NoNode) {
+		const Doc& d = docs[item.nameDoc];
+		const OffsetT* entry = &d.tape[item.nameEntry];
+		size_t begin = entryPosition(entry);
+		return writeRaw(item.nameDoc, begin, begin + getTokenLength(entry, d.json), item.nameEntry, 2);
+	}
+	// decoded from a path, quoted again
+	GrowableSink quoted(item.nameLength + 16);
+	if (!WriteString(quoted, names + item.nameOffset, item.nameLength)) {
+		ErrorMessage = "out of memory";
+		return false;
+	}
+	if (outTape) {
+		OffsetT* p = outTape->Allocate(2);
+		if (!p) {
+			ErrorMessage = "out of memory";
+			return false;
+		}
+		bool hasEscapes = memchr(quoted.GetData(), '\\', quoted.GetLength()) != 0;
+		writeScalar(p, outPos, quoted.GetLength(), Type_string, hasEscapes);
+	}
+	sink->Write(quoted.GetData(), quoted.GetLength());
+	outPos += quoted.GetLength();
+	return true;
+}
+
+// Copies [begin, end) of doc and the tape words from entry on, with the
+// positions moved to where the bytes end up.
+template <typename OffsetT>
+bool PatcherT<OffsetT>::writeRaw(size_t doc, size_t begin, size_t end, size_t entry, size_t words)
+{
+	const Doc& d = docs[doc];
+	sink->Write(d.json + begin, end - begin);
+	if (outTape) {
+		OffsetT* p = outTape->Allocate(words);
+		if (!p) {
+			ErrorMessage = "out of memory";
+			return false;
+		}
+		memcpy(p, d.tape + entry, words * sizeof(OffsetT));
+		// a position past MaxPosition shows in outPos
+		for (size_t i=0; i<words; i+=2) {
+			ValueHeader<OffsetT>* vh = (ValueHeader<OffsetT>*) &p[i];
+			if (!vh->isContainer) {
+				vh->position = (OffsetT)(vh->position - begin + outPos);
+			}
+		}
+	}
+	outPos += end - begin;
+	return true;
+}
+
+template <typename OffsetT>
+bool PatcherT<OffsetT>::finish(OutputSink& sink, TapeArenaT<OffsetT>* newTape)
+{
+	this->sink = &sink;
+	outTape = newTape;
+	outPos = 0;
+	tooLarge = false;
+	if (newTape) {
+		newTape->Reset();
+	}
+	bool ok = writeNode(root);
+	this->sink = 0;
+	outTape = 0;
+	if (!ok) {
+		return false;
+	}
+	if (sink.Failed()) {
+		ErrorMessage = "output sink full";
+		return false;
+	}
+	if (newTape && (tooLarge || outPos > TapeLimits<OffsetT>::MaxPosition)) {
+		ErrorMessage = "patched document too large for tape offset width";
+		return false;
+	}
+	return true;
+}
+
+template <typename OffsetT>
+bool PatcherT<OffsetT>::ApplyPatch(const char* patch, size_t len, OutputSink& sink, TapeArenaT<OffsetT>* newTape)
+{
+	if (!begin(patch, len)) {
+		return false;
+	}
+	const OffsetT* tape = docs[1].tape;
+	if (isObjectEntry(tape)) {
+		ErrorMessage = "patch is not an array";
+		return false;
+	}
+	PatchSpan ops;
+	rootSpan(1, ops);
+	size_t count = getCount(*tape);
+	size_t e = 2;
+	for (size_t i=0; i<count; ++i, e+=entrySize(&tape[e])) {
+		ErrorOperation = i;
+		PatchSpan opSpan;
+		childSpan(ops, e, opSpan);
+		if (!apply(e, opSpan)) {
+			return false;
+		}
+	}
+	return finish(sink, newTape);
+}
+
+template <typename OffsetT>
+bool PatcherT<OffsetT>::ApplyMergePatch(const char* patch, size_t len, OutputSink& sink, TapeArenaT<OffsetT>* newTape)
+{
+	size_t p = skipSpace(patch, len, 0);
+	if (p < len && patch[p] != '{' && patch[p] != '[') {
+		reset();
+		ErrorMessage = "root is not an object or array";
+		return false;
+	}
+	if (!begin(patch, len)) {
+		return false;
+	}
+	PatchSpan span;
+	rootSpan(1, span);
+	if (!isObjectEntry(docs[1].tape)) {
+		// anything but an object replaces the document
+		root = newSpanNode(span);
+		return root != NoNode && finish(sink, newTape);
+	}
+	if (!isObjectNode(root)) {
+		makeEmptyObject(root);
+	}
+	if (!materialize(root) || !mergeObject(root, span)) {
+		return false;
+	}
+	return finish(sink, newTape);
+}
+
+template struct PatcherT<uint16_t>;
+template struct PatcherT<uint32_t>;
+
+} // namespace json16
+
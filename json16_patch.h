@@ -0,0 +1,145 @@
+#pragma once
+
+#include "json16.h"
+#include "json16_writer.h"
+#include "json16_context.h"
+
+namespace json16 {
+
+/*
+
+Applies JSON Patch (RFC 6902) and JSON Merge Patch (RFC 7396) documents to a
+parsed document and writes the patched JSON text.
+
+The operations are applied to an overlay of the tape first: only the
+containers a path leads through are rebuilt, as runs of their untouched
+members plus the members that changed. Nothing is written when an operation
+fails. The text is then written in one go; every run is a single copy of the
+source bytes between the first and the last member, and members that were
+moved or come from the patch are copied as the byte range of their value.
+Rebuilding a container costs a lookup per operation (the side index makes
+that constant for wide objects and long arrays), not a walk of its members.
+Member names are expected to be unique, a path refers to the first of
+several members with the same name.
+
+When a tape arena is passed in, the tape of the result is written too, from
+the tape words of the runs and values with their positions moved, so the
+result can be read through ParserT(text, tape) without parsing it again.
+The positions count from the first byte written to the sink.
+
+*/
+
+struct PatchSpan;
+struct PatchItem;
+struct PatchNode;
+struct PatchLoc;
+
+template <typename OffsetT>
+struct PatcherT
+{
+public:
+	// the document, its tape and optionally its side index
+	PatcherT(const char* json, size_t len, const OffsetT* tape, const OffsetT* index = 0);
+	~PatcherT();
+	
+	// Applies the array of operations in patch. newTape, when given, is reset
+	// and receives the tape of the result.
+	bool ApplyPatch(const char* patch, size_t len, OutputSink& sink, TapeArenaT<OffsetT>* newTape = 0);
+	// Merges patch into the document, see ApplyPatch. The patch has to be an
+	// object or an array, like any root a tape can hold; a scalar, which would
+	// replace the whole document, fails with "root is not an object or array".
+	bool ApplyMergePatch(const char* patch, size_t len, OutputSink& sink, TapeArenaT<OffsetT>* newTape = 0);
+	
+	const char* ErrorMessage;
+	size_t ErrorOperation;		// index of the operation ErrorMessage refers to
+	
+private:
+	PatcherT(const PatcherT&);
+	PatcherT& operator=(const PatcherT&);
+	
+	struct Doc
+	{
+		const char* json;
+		size_t len;
+		const OffsetT* tape;
+		const OffsetT* index;
+	};
+	
+	bool begin(const char* patch, size_t len);
+	bool finish(OutputSink& sink, TapeArenaT<OffsetT>* newTape);
+	void reset();
+	void rootSpan(size_t doc, PatchSpan& span) const;
+	
+	// overlay
+	size_t newNode();
+	size_t newSpanNode(const PatchSpan& span);
+	size_t newContainerNode(bool isObject);
+	bool materialize(size_t node);
+	void makeEmptyObject(size_t node);
+	bool replaceItems(size_t node, size_t at, size_t removeCount, const PatchItem* with, size_t n);
+	bool splitRun(size_t node, size_t at, size_t cutBegin, size_t cutEnd, size_t localBegin, size_t localEnd, const PatchItem* mid);
+	bool appendMember(size_t node, size_t nameDoc, size_t nameEntry, size_t value);
+	size_t cloneNode(size_t node);
+	bool isObjectNode(size_t node) const;
+	size_t memberCount(size_t node, const PatchItem& item) const;
+	size_t elementCount(size_t node) const;
+	
+	// lookup
+	bool findMember(size_t node, const char* key, size_t len, PatchLoc& loc);
+	bool findElement(size_t node, size_t index, PatchLoc& loc);
+	bool locate(size_t node, const char* token, size_t len, PatchLoc& loc);
+	size_t extract(size_t node, const PatchLoc& loc);
+	bool setAt(size_t node, const PatchLoc& loc, size_t value);
+	bool removeAt(size_t node, const PatchLoc& loc);
+	size_t resolveParent(char* path, char* end, const char*& last, size_t& lastLength);
+	bool resolveValue(char* path, char* end, size_t& node, PatchSpan& span);
+	const char* unescapeKey(const StringRef& name, size_t& len);
+	
+	// operations
+	bool apply(size_t op, const PatchSpan& opSpan);
+	bool setRoot(size_t value);
+	bool add(char* path, char* end, size_t value);
+	bool remove(char* path, char* end, size_t* removed);
+	bool replace(char* path, char* end, size_t value);
+	bool mergeObject(size_t node, const PatchSpan& patch);
+	
+	// value comparison for test
+	bool equalValues(size_t aNode, size_t aDoc, size_t aEntry, size_t bDoc, size_t bEntry);
+	bool equalEntries(size_t aDoc, size_t aEntry, size_t bDoc, size_t bEntry);
+	
+	// byte ranges
+	size_t memberStart(const PatchSpan& container, size_t x) const;
+	size_t valueStart(const PatchSpan& container, size_t v) const;
+	size_t memberEndBefore(const PatchSpan& container, size_t x) const;
+	void childSpan(const PatchSpan& container, size_t v, PatchSpan& span) const;
+	
+	// output
+	bool writeNode(size_t node);
+	bool writeName(const PatchItem& item);
+	bool writeRaw(size_t doc, size_t begin, size_t end, size_t entry, size_t words);
+	
+	Doc docs[2];		// the document and the patch
+	TapeArenaT<OffsetT> patchTape;
+	PatchNode* nodes;
+	size_t nodeCount;
+	size_t nodeCapacity;
+	size_t root;
+	char* names;		// decoded path tokens that became member names
+	size_t namesUsed;
+	size_t namesCapacity;
+	char* buff;			// unescaped path and from
+	size_t buffCapacity;
+	char* keyBuff;		// unescaped member name of the patch
+	size_t keyCapacity;
+	
+	OutputSink* sink;
+	TapeArenaT<OffsetT>* outTape;
+	size_t outPos;
+	bool tooLarge;
+};
+
+typedef PatcherT<uint16_t> Patcher;
+typedef PatcherT<uint32_t> Patcher32;
+
+} // namespace json16
+
@@ -0,0 +1,266 @@
+#include "json16_path.h"
+#include "json16_tape.h"
+
+#include <string.h>
+
+namespace json16 {
+
+Path::Path(const char* pointer, size_t len)
+	:
+	ErrorMessage(0),
+	stepCount(0)
+{
+	if (len == 0) {
+		return;
+	}
+	if (*pointer != '/') {
+		ErrorMessage = "pointer does not start with /";
+		return;
+	}
+	const char* p = pointer;
+	const char* end = pointer + len;
+	size_t textPos = 0;
+	while (p != end) {
+		++p;	// '/'
+		if (stepCount == MaxSteps) {
+			ErrorMessage = "too many pointer tokens";
+			return;
+		}
+		const char* tokenEnd = (const char*) memchr(p, '/', end - p);
+		if (!tokenEnd) {
+			tokenEnd = end;
+		}
+		Step& step = steps[stepCount++];
+		step.nameOffset = (uint16_t) textPos;
+		step.isWildcard = (tokenEnd - p == 1 && *p == '*');
+		for (; p!=tokenEnd; ++p) {
+			if (textPos == MaxTextLength) {
+				ErrorMessage = "pointer too long";
+				return;
+			}
+			char c = *p;
+			if (c == '~') {
+				if (p + 1 == tokenEnd || (p[1] != '0' && p[1] != '1')) {
+					ErrorMessage = "invalid ~ escape in pointer";
+					return;
+				}
+				c = (p[1] == '0') ? '~' : '/';
+				++p;
+			}
+			text[textPos++] = c;
+		}
+		step.nameLength = (uint16_t) (textPos - step.nameOffset);
+		
+		// array index: digits without leading zeros
+		const char* name = text + step.nameOffset;
+		step.isIndex = (step.nameLength > 0) && (step.nameLength == 1 || name[0] != '0');
+		step.index = 0;
+		for (size_t i=0; i<step.nameLength && step.isIndex; ++i) {
+			unsigned d = name[i] - '0';
+			if (d >= 10 || step.index > ((size_t)~0 - d) / 10) {
+				step.isIndex = false;
+			}else {
+				step.index = step.index * 10 + d;
+			}
+		}
+	}
+}
+
+namespace {
+
+template <typename OffsetT>
+struct PathWalk
+{
+	const char* src;
+	const OffsetT* tape;
+	const OffsetT* index;
+	const Path* paths;
+	size_t base;
+	PathVisitorT<OffsetT>* visitor;
+	uint64_t endsAt[Path::MaxSteps + 1];	// paths with exactly that many steps
+	uint64_t wildcardAt[Path::MaxSteps];
+	
+	static bool stepMatches(const Path& path, size_t depth, bool isObject, const StringRef& name, size_t i)
+	{
+		const Path::Step& step = path.GetStep(depth);
+		if (step.isWildcard) {
+			return true;
+		}
+		if (isObject) {
+			return nameEquals(name, path.GetName(step), step.nameLength);
+		}
+		return step.isIndex && step.index == i;
+	}
+	
+	// value at entry matched the paths in hit at depth, report or descend
+	void onHit(OffsetT containerOffset, size_t entry, size_t depth, uint64_t hit)
+	{
+		uint64_t done = hit & endsAt[depth + 1];
+		for (uint64_t bits=done; bits; bits&=bits-1) {
+			ObjectReaderT<OffsetT> value(containerOffset, src, tape, index, (OffsetT)entry);
+			visitor->OnMatch(base + lowestBit(bits), value);
+		}
+		uint64_t deeper = hit & ~done;
+		if (deeper && isContainerEntry(&tape[entry])) {
+			walk((OffsetT)entry, depth + 1, deeper);
+		}
+	}
+	
+	static size_t lowestBit(uint64_t bits)
+	{
+		size_t n = 0;
+		while (!(bits & 1)) {
+			bits >>= 1;
+			++n;
+		}
+		return n;
+	}
+	
+	// The value entry of the step of path p in the container of table, 0 when none.
+	size_t lookUp(const OffsetT* table, bool isObject, size_t count, size_t p, size_t depth)
+	{
+		const Path::Step& step = paths[p].GetStep(depth);
+		if (!isObject) {
+			return (step.isIndex && step.index < count) ? table[1 + step.index] : 0;
+		}
+		const char* key = paths[p].GetName(step);
+		size_t mask = table[0] - 1;
+		for (size_t i=hashName(key, step.nameLength)&mask; ; i=(i+1)&mask) {
+			OffsetT e = table[1 + i];
+			if (!e) {
+				return 0;
+			}
+			if (nameEquals(getStringRef(&tape[e], src), key, step.nameLength)) {
+				return e + 2;
+			}
+		}
+	}
+	
+	// uses the name hash table of a wide object or the element table of a long
+	// array, returns false when the container has none
+	bool walkIndexed(OffsetT containerOffset, const ContainerHeader<OffsetT>& ch, size_t depth, uint64_t active)
+	{
+		const OffsetT* table = index ? findTable(index, containerOffset) : 0;
+		if (!table) {
+			return false;
+		}
+		size_t entries[64];
+		uint64_t hits[64];
+		size_t n = 0;
+		for (uint64_t bits=active; bits; bits&=bits-1) {
+			size_t p = lowestBit(bits);
+			size_t valueEntry = lookUp(table, ch.isObject, ch.count, p, depth);
+			if (!valueEntry) {
+				continue;
+			}
+			size_t j = 0;
+			while (j < n && entries[j] != valueEntry) {
+				++j;
+			}
+			if (j == n) {
+				entries[n] = valueEntry;
+				hits[n] = 0;
+				++n;
+			}
+			hits[j] |= (uint64_t)1 << p;
+		}
+		// report in document order
+		for (size_t i=1; i<n; ++i) {
+			for (size_t j=i; j>0 && entries[j-1] > entries[j]; --j) {
+				size_t e = entries[j]; entries[j] = entries[j-1]; entries[j-1] = e;
+				uint64_t h = hits[j]; hits[j] = hits[j-1]; hits[j-1] = h;
+			}
+		}
+		for (size_t i=0; i<n; ++i) {
+			onHit(containerOffset, entries[i], depth, hits[i]);
+		}
+		return true;
+	}
+	
+	void walk(OffsetT containerOffset, size_t depth, uint64_t active)
+	{
+		ContainerHeader<OffsetT> ch = *(const ContainerHeader<OffsetT>*) &tape[containerOffset];
+		uint64_t wildcards = active & wildcardAt[depth];
+		if (!wildcards && walkIndexed(containerOffset, ch, depth, active)) {
+			return;
+		}
+		// paths without a wildcard here match at most one member
+		uint64_t pending = active & ~wildcards;
+		size_t e = containerOffset + 2;
+		StringRef name = StringRef();
+		for (size_t i=0; i<ch.count; ++i) {
+			if (ch.isObject) {
+				name = getStringRef(&tape[e], src);
+				e += 2;
+			}
+			uint64_t hit = 0;
+			for (uint64_t bits=active; bits; bits&=bits-1) {
+				size_t p = lowestBit(bits);
+				if (stepMatches(paths[p], depth, ch.isObject, name, i)) {
+					hit |= (uint64_t)1 << p;
+				}
+			}
+			if (hit) {
+				onHit(containerOffset, e, depth, hit);
+				pending &= ~hit;
+				if (!pending && !wildcards) {
+					return;
+				}
+			}
+			e += entrySize(&tape[e]);
+		}
+	}
+};
+
+} // anonymous namespace
+
+template <typename OffsetT>
+void MatchPaths(const ObjectReaderT<OffsetT>& root, const Path* paths, size_t pathCount, PathVisitorT<OffsetT>& visitor)
+{
+	// 64 paths per walk, one bit each
+	for (size_t base=0; base<pathCount; base+=64) {
+		size_t n = pathCount - base;
+		if (n > 64) {
+			n = 64;
+		}
+		PathWalk<OffsetT> w;
+		w.src = root.GetSource();
+		w.tape = root.GetTape();
+		w.index = root.GetIndex();
+		w.paths = paths + base;
+		w.base = base;
+		w.visitor = &visitor;
+		memset(w.endsAt, 0, sizeof(w.endsAt));
+		memset(w.wildcardAt, 0, sizeof(w.wildcardAt));
+		uint64_t active = 0;
+		for (size_t i=0; i<n; ++i) {
+			const Path& path = paths[base + i];
+			if (path.ErrorMessage) {
+				continue;
+			}
+			uint64_t bit = (uint64_t)1 << i;
+			w.endsAt[path.GetStepCount()] |= bit;
+			for (size_t d=0; d<path.GetStepCount(); ++d) {
+				if (path.GetStep(d).isWildcard) {
+					w.wildcardAt[d] |= bit;
+				}
+			}
+			active |= bit;
+		}
+		OffsetT rootOffset = root.GetTapeOffset();
+		for (uint64_t bits=active&w.endsAt[0]; bits; bits&=bits-1) {
+			ObjectReaderT<OffsetT> value(rootOffset, w.src, w.tape, w.index, rootOffset);
+			visitor.OnMatch(base + PathWalk<OffsetT>::lowestBit(bits), value);
+		}
+		active &= ~w.endsAt[0];
+		if (active) {
+			w.walk(rootOffset, 0, active);
+		}
+	}
+}
+
+template void MatchPaths(const ObjectReaderT<uint16_t>&, const Path*, size_t, PathVisitorT<uint16_t>&);
+template void MatchPaths(const ObjectReaderT<uint32_t>&, const Path*, size_t, PathVisitorT<uint32_t>&);
+
+} // namespace json16
+
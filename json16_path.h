@@ -0,0 +1,57 @@
+#pragma once
+
+#include "json16.h"
+
+namespace json16 {
+
+// Compiled RFC 6901 JSON Pointer, e.g. "/data/items/*/price".
+// "" selects the root. As an extension a "*" token matches every
+// array element and every object member.
+struct Path
+{
+public:
+	enum {
+		MaxSteps = 16,		// the parser does not nest deeper than this
+		MaxTextLength = 256,
+	};
+	
+	struct Step
+	{
+		uint16_t nameOffset;	// unescaped name in text
+		uint16_t nameLength;
+		bool isWildcard;
+		bool isIndex;			// token is a valid array index
+		size_t index;
+	};
+	
+	Path(const char* pointer, size_t len);
+	
+	size_t GetStepCount() const { return stepCount; }
+	const Step& GetStep(size_t i) const { return steps[i]; }
+	const char* GetName(const Step& step) const { return text + step.nameOffset; }
+	
+	const char* ErrorMessage;
+private:
+	size_t stepCount;
+	Step steps[MaxSteps];
+	char text[MaxTextLength];
+};
+
+template <typename OffsetT>
+struct PathVisitorT
+{
+	virtual ~PathVisitorT() {}
+	// value has its cursor on the matched value
+	virtual void OnMatch(size_t pathIndex, ObjectReaderT<OffsetT>& value) = 0;
+};
+
+// Evaluates all paths in a single walk over the container of root.
+// Subtrees that no path can match are skipped with the container size.
+template <typename OffsetT>
+void MatchPaths(const ObjectReaderT<OffsetT>& root, const Path* paths, size_t pathCount, PathVisitorT<OffsetT>& visitor);
+
+typedef PathVisitorT<uint16_t> PathVisitor;
+typedef PathVisitorT<uint32_t> PathVisitor32;
+
+} // namespace json16
+
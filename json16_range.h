@@ -0,0 +1,204 @@
+#pragma once
+
+#include "json16.h"
+#include "json16_entry.h"
+#include "json16_number.h"
+
+namespace json16 {
+
+/*
+
+Iterators over the members of an object and the elements of an array, as an
+alternative to the cursor of the readers:
+
+	for (auto [name, value] : parser.GetObject()) {
+		if (value.GetValueType() == json16::Type_number) ...
+	}
+	for (auto value : parser.GetArray()) ...
+
+Without C++11, begin() and end() are called by hand:
+
+	for (json16::MemberIterator it=begin(obj); it!=end(obj); ++it) {
+		json16::Member m = *it;
+		...
+	}
+
+An iterator is a pointer into the tape plus the source and tape it belongs
+to, all of it defined here so that the loops inline. The tape entries are
+read through json16_entry.h, the tape internals stay out of user code.
+Iteration always covers the whole container, wherever the cursor of the
+reader is.
+
+*/
+
+// One value on the tape. Its type is read once, when it is taken out of an iterator.
+template <typename OffsetT>
+struct ValueRefT
+{
+public:
+	ValueRefT(const OffsetT* entry, const char* src, const OffsetT* tape, const OffsetT* index)
+		:
+		entry(entry),
+		src(src),
+		tape(tape),
+		index(index),
+		type(detail::valueType(entry))
+	{
+	}
+	
+	Type GetValueType() const { return type; }
+	StringRef GetStringRef() const { return detail::stringValue(entry, src); }
+	double GetNumber() const
+	{
+		size_t len;
+		const char* p = detail::numberText(entry, src, len);
+		return ParseDouble(p, len);
+	}
+	// false when the number has a fraction/exponent or is out of range
+	bool GetInt64(int64_t& value) const
+	{
+		size_t len;
+		const char* p = detail::numberText(entry, src, len);
+		return ParseInt64(p, len, value);
+	}
+	bool GetUInt64(uint64_t& value) const
+	{
+		size_t len;
+		const char* p = detail::numberText(entry, src, len);
+		return ParseUInt64(p, len, value);
+	}
+	// the number token as written, for decimal types
+	const char* GetNumberText(size_t& length) const { return detail::numberText(entry, src, length); }
+	ObjectReaderT<OffsetT> GetObject() const { return ObjectReaderT<OffsetT>((OffsetT)(entry - tape), src, tape, index); }
+	ArrayReaderT<OffsetT> GetArray() const { return ArrayReaderT<OffsetT>((OffsetT)(entry - tape), src, tape, index); }
+	
+private:
+	const OffsetT* entry;
+	const char* src;
+	const OffsetT* tape;
+	const OffsetT* index;
+	Type type;
+};
+
+template <typename OffsetT>
+struct MemberT
+{
+	StringRef name;
+	ValueRefT<OffsetT> value;
+};
+
+template <typename OffsetT>
+struct MemberIteratorT
+{
+public:
+	MemberIteratorT(const OffsetT* entry, const char* src, const OffsetT* tape, const OffsetT* index)
+		:
+		entry(entry),
+		src(src),
+		tape(tape),
+		index(index)
+	{
+	}
+	
+	MemberT<OffsetT> operator * () const
+	{
+		MemberT<OffsetT> m = { detail::stringValue(entry, src), ValueRefT<OffsetT>(entry + 2, src, tape, index) };
+		return m;
+	}
+	MemberIteratorT& operator ++ ()
+	{
+		entry += 2;
+		entry += detail::entrySize(entry);
+		return *this;
+	}
+	bool operator == (const MemberIteratorT& other) const { return entry == other.entry; }
+	bool operator != (const MemberIteratorT& other) const { return entry != other.entry; }
+	
+private:
+	const OffsetT* entry;	// name of the member
+	const char* src;
+	const OffsetT* tape;
+	const OffsetT* index;
+};
+
+template <typename OffsetT>
+struct ElementIteratorT
+{
+public:
+	ElementIteratorT(const OffsetT* entry, const char* src, const OffsetT* tape, const OffsetT* index)
+		:
+		entry(entry),
+		src(src),
+		tape(tape),
+		index(index)
+	{
+	}
+	
+	ValueRefT<OffsetT> operator * () const { return ValueRefT<OffsetT>(entry, src, tape, index); }
+	ElementIteratorT& operator ++ ()
+	{
+		entry += detail::entrySize(entry);
+		return *this;
+	}
+	bool operator == (const ElementIteratorT& other) const { return entry == other.entry; }
+	bool operator != (const ElementIteratorT& other) const { return entry != other.entry; }
+	
+private:
+	const OffsetT* entry;
+	const char* src;
+	const OffsetT* tape;
+	const OffsetT* index;
+};
+
+// first word past the container of reader
+template <typename OffsetT>
+inline
+const OffsetT* containerEnd(const ObjectReaderT<OffsetT>& reader)
+{
+	const OffsetT* container = reader.GetTape() + reader.GetTapeOffset();
+	return container + detail::entrySize(container);
+}
+
+// found by argument dependent lookup, also by range based for
+template <typename OffsetT>
+inline
+MemberIteratorT<OffsetT> begin(const ObjectReaderT<OffsetT>& obj)
+{
+	const OffsetT* tape = obj.GetTape();
+	return MemberIteratorT<OffsetT>(tape + obj.GetTapeOffset() + 2, obj.GetSource(), tape, obj.GetIndex());
+}
+
+template <typename OffsetT>
+inline
+MemberIteratorT<OffsetT> end(const ObjectReaderT<OffsetT>& obj)
+{
+	return MemberIteratorT<OffsetT>(containerEnd(obj), obj.GetSource(), obj.GetTape(), obj.GetIndex());
+}
+
+template <typename OffsetT>
+inline
+ElementIteratorT<OffsetT> begin(const ArrayReaderT<OffsetT>& arr)
+{
+	const OffsetT* tape = arr.GetTape();
+	return ElementIteratorT<OffsetT>(tape + arr.GetTapeOffset() + 2, arr.GetSource(), tape, arr.GetIndex());
+}
+
+template <typename OffsetT>
+inline
+ElementIteratorT<OffsetT> end(const ArrayReaderT<OffsetT>& arr)
+{
+	return ElementIteratorT<OffsetT>(containerEnd(arr), arr.GetSource(), arr.GetTape(), arr.GetIndex());
+}
+
+typedef ValueRefT<uint16_t> ValueRef;
+typedef MemberT<uint16_t> Member;
+typedef MemberIteratorT<uint16_t> MemberIterator;
+typedef ElementIteratorT<uint16_t> ElementIterator;
+
+typedef ValueRefT<uint32_t> ValueRef32;
+typedef MemberT<uint32_t> Member32;
+typedef MemberIteratorT<uint32_t> MemberIterator32;
+typedef ElementIteratorT<uint32_t> ElementIterator32;
+
+} // namespace json16
+
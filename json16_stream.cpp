@@ -0,0 +1,395 @@
+#include "json16_stream.h"
+#include "json16_indexer.h"
+
+namespace json16 {
+
+template <typename OffsetT>
+StreamParserT<OffsetT>::StreamParserT(OffsetT* work, size_t capacity)
+	:
+	ErrorMessage(0),
+	builder(work, capacity),
+	arena(0),
+	offset(0),
+	state(Lex_None),
+	tokenStart(0),
+	hasEscapes(false),
+	hexRemaining(0),
+	utf8Remaining(0),
+	utf8Low(0),
+	utf8High(0),
+	numberState(Num_Minus),
+	literal(0),
+	literalMatched(0),
+	literalToken(TOKEN_NULL)
+{
+}
+
+template <typename OffsetT>
+StreamParserT<OffsetT>::StreamParserT(TapeArenaT<OffsetT>& arena)
+	:
+	ErrorMessage(0),
+	builder(0),
+	arena(&arena),
+	offset(0),
+	state(Lex_None),
+	tokenStart(0),
+	hasEscapes(false),
+	hexRemaining(0),
+	utf8Remaining(0),
+	utf8Low(0),
+	utf8High(0),
+	numberState(Num_Minus),
+	literal(0),
+	literalMatched(0),
+	literalToken(TOKEN_NULL)
+{
+	arena.Reset();
+}
+
+// doubles the room for the tape in the arena
+template <typename OffsetT>
+bool StreamParserT<OffsetT>::growTape()
+{
+	if (!arena) {
+		ErrorMessage = "tape capacity exceeded";
+		return false;
+	}
+	size_t used = builder.pWork - builder.work;
+	size_t words = builder.workEnd - builder.work;
+	size_t more = words ? words : 256;
+	if (!arena->Allocate(more)) {
+		ErrorMessage = "out of memory";
+		return false;
+	}
+	// the block may have moved
+	OffsetT* memory = arena->GetMemory();
+	builder.work = memory;
+	builder.pWork = memory + used;
+	builder.workEnd = memory + words + more;
+	return true;
+}
+
+template <typename OffsetT>
+bool StreamParserT<OffsetT>::token(TokenType tt, size_t start, size_t length, bool hasEscapes)
+{
+	// the strict builder leaves checking the room to its caller, values and
+	// opening brackets take two words
+	bool writes = (tt & TOKEN_VALUE) || tt == TOKEN_LEFT_BRACE || tt == TOKEN_LEFT_BRACKET;
+	if (writes && builder.workEnd - builder.pWork < 2 && !growTape()) {
+		return false;
+	}
+	if (!builder.Token(tt, start, length, hasEscapes)) {
+		ErrorMessage = builder.ErrorMessage;
+		return false;
+	}
+	return true;
+}
+
+template <typename OffsetT>
+bool StreamParserT<OffsetT>::advanceNumber(char c)
+{
+	bool isDigit = (c >= '0' && c <= '9');
+	switch (numberState) {
+	case Num_Minus:
+		if (!isDigit) {
+			return false;
+		}
+		numberState = (c == '0') ? Num_Zero : Num_Int;
+		return true;
+	case Num_Int:
+		if (isDigit) {
+			return true;
+		}
+		// fall through
+	case Num_Zero:
+		if (c == '.') {
+			numberState = Num_Dot;
+			return true;
+		}
+		if (c == 'e' || c == 'E') {
+			numberState = Num_Exp;
+			return true;
+		}
+		return false;
+	case Num_Dot:
+		if (!isDigit) {
+			return false;
+		}
+		numberState = Num_Frac;
+		return true;
+	case Num_Frac:
+		if (isDigit) {
+			return true;
+		}
+		if (c == 'e' || c == 'E') {
+			numberState = Num_Exp;
+			return true;
+		}
+		return false;
+	case Num_Exp:
+		if (c == '+' || c == '-') {
+			numberState = Num_ExpSign;
+			return true;
+		}
+		// fall through
+	case Num_ExpSign:
+	case Num_ExpDigits:
+		if (!isDigit) {
+			return false;
+		}
+		numberState = Num_ExpDigits;
+		return true;
+	}
+	return false;
+}
+
+template <typename OffsetT>
+bool StreamParserT<OffsetT>::Feed(const char* chunk, size_t len)
+{
+	if (ErrorMessage) {
+		return false;
+	}
+	if (len > TapeLimits<OffsetT>::MaxPosition - offset) {
+		ErrorMessage = "document too large for tape offset width";
+		return false;
+	}
+	size_t base = offset;
+	offset += len;
+	const char* p = chunk;
+	const char* end = chunk + len;
+	while (p != end) {
+		char c = *p;
+		size_t pos = base + (p - chunk);
+		switch (state) {
+		case Lex_None:
+			++p;
+			switch (c) {
+			case ' ': case '\t': case '\n': case '\v': case '\f': case '\r':
+				break;
+			case '"':
+				state = Lex_String;
+				tokenStart = pos;
+				hasEscapes = false;
+				break;
+			case '{':
+				if (!token(TOKEN_LEFT_BRACE, pos, 1, false)) {
+					return false;
+				}
+				break;
+			case '}':
+				if (!token(TOKEN_RIGHT_BRACE, pos, 1, false)) {
+					return false;
+				}
+				break;
+			case '[':
+				if (!token(TOKEN_LEFT_BRACKET, pos, 1, false)) {
+					return false;
+				}
+				break;
+			case ']':
+				if (!token(TOKEN_RIGHT_BRACKET, pos, 1, false)) {
+					return false;
+				}
+				break;
+			case ':':
+				if (!token(TOKEN_COLON, pos, 1, false)) {
+					return false;
+				}
+				break;
+			case ',':
+				if (!token(TOKEN_COMMA, pos, 1, false)) {
+					return false;
+				}
+				break;
+			case '-':
+				state = Lex_Number;
+				tokenStart = pos;
+				numberState = Num_Minus;
+				break;
+			case '0':
+				state = Lex_Number;
+				tokenStart = pos;
+				numberState = Num_Zero;
+				break;
+			case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9':
+				state = Lex_Number;
+				tokenStart = pos;
+				numberState = Num_Int;
+				break;
+			case 't':
+			case 'f':
+			case 'n':
+				state = Lex_Literal;
+				tokenStart = pos;
+				literal = (c == 't') ? "true" : (c == 'f') ? "false" : "null";
+				literalToken = (c == 't') ? TOKEN_TRUE : (c == 'f') ? TOKEN_FALSE : TOKEN_NULL;
+				literalMatched = 1;
+				break;
+			default:
+				ErrorMessage = "invalid token";
+				return false;
+			}
+			break;
+		case Lex_String:
+			// plain characters, the common case
+			while (c != '"' && c != '\\' && (unsigned char)c >= 0x20 && (unsigned char)c < 0x80) {
+				if (++p == end) {
+					return true;
+				}
+				c = *p;
+			}
+			++p;
+			if (c == '"') {
+				state = Lex_None;
+				if (!token(TOKEN_STRING, tokenStart, base + (p - chunk) - tokenStart, hasEscapes)) {
+					return false;
+				}
+			}else if (c == '\\') {
+				state = Lex_Escape;
+				hasEscapes = true;
+			}else if ((unsigned char)c >= 0x80) {
+				utf8Remaining = utf8SequenceLength((unsigned char)c, utf8Low, utf8High);
+				if (utf8Remaining == 0) {
+					ErrorMessage = "invalid UTF-8";
+					return false;
+				}
+				--utf8Remaining;
+				state = Lex_Utf8;
+			}else {
+				ErrorMessage = "invalid character in string";
+				return false;
+			}
+			break;
+		case Lex_Escape:
+			++p;
+			switch (c) {
+			case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+				state = Lex_String;
+				break;
+			case 'u':
+				state = Lex_Unicode;
+				hexRemaining = 4;
+				break;
+			default:
+				ErrorMessage = "invalid escape sequence in string";
+				return false;
+			}
+			break;
+		case Lex_Unicode:
+			if (!isHexDigit(c)) {
+				ErrorMessage = "invalid escape sequence in string";
+				return false;
+			}
+			++p;
+			if (--hexRemaining == 0) {
+				state = Lex_String;
+			}
+			break;
+		case Lex_Utf8:
+			if ((unsigned char)c < utf8Low || (unsigned char)c > utf8High) {
+				ErrorMessage = "invalid UTF-8";
+				return false;
+			}
+			++p;
+			utf8Low = 0x80;
+			utf8High = 0xBF;
+			if (--utf8Remaining == 0) {
+				state = Lex_String;
+			}
+			break;
+		case Lex_Number:
+			if (!isDelimiter(c)) {
+				if (!advanceNumber(c)) {
+					ErrorMessage = "invalid token";
+					return false;
+				}
+				++p;
+				break;
+			}
+			if (numberState != Num_Zero && numberState != Num_Int
+				&& numberState != Num_Frac && numberState != Num_ExpDigits
+			) {
+				ErrorMessage = "invalid token";
+				return false;
+			}
+			// the delimiter is lexed again in Lex_None
+			state = Lex_None;
+			if (!token(TOKEN_NUMBER, tokenStart, pos - tokenStart, false)) {
+				return false;
+			}
+			break;
+		case Lex_Literal:
+			if (literal[literalMatched]) {
+				if (c != literal[literalMatched]) {
+					ErrorMessage = "invalid token";
+					return false;
+				}
+				++literalMatched;
+				++p;
+				break;
+			}
+			if (!isDelimiter(c)) {
+				ErrorMessage = "invalid token";
+				return false;
+			}
+			state = Lex_None;
+			if (!token(literalToken, tokenStart, literalMatched, false)) {
+				return false;
+			}
+			break;
+		}
+	}
+	return true;
+}
+
+template <typename OffsetT>
+bool StreamParserT<OffsetT>::Finish()
+{
+	if (ErrorMessage) {
+		return false;
+	}
+	switch (state) {
+	case Lex_None:
+		break;
+	case Lex_String:
+	case Lex_Escape:
+	case Lex_Unicode:
+	case Lex_Utf8:
+		ErrorMessage = "unterminated string";
+		return false;
+	case Lex_Number:
+	case Lex_Literal:
+		// the root is always a container so a scalar can never end the input
+		ErrorMessage = "unexpected end of input";
+		return false;
+	}
+	if (!builder.Finish()) {
+		ErrorMessage = builder.ErrorMessage;
+		return false;
+	}
+	return true;
+}
+
+template <typename OffsetT>
+Type StreamParserT<OffsetT>::GetValueType() const
+{
+	return getValueType((const OffsetT*)builder.work);
+}
+
+template <typename OffsetT>
+ObjectReaderT<OffsetT> StreamParserT<OffsetT>::GetObject(const char* json) const
+{
+	return ObjectReaderT<OffsetT>(0, json, builder.work);
+}
+
+template <typename OffsetT>
+ArrayReaderT<OffsetT> StreamParserT<OffsetT>::GetArray(const char* json) const
+{
+	return ArrayReaderT<OffsetT>(0, json, builder.work);
+}
+
+template struct StreamParserT<uint16_t>;
+template struct StreamParserT<uint32_t>;
+
+} // namespace json16
+
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "json16.h"
+#include "json16_builder.h"
+#include "json16_context.h"
+
+namespace json16 {
+
+// Push parser for input that arrives in pieces.
+// Chunks may be split anywhere, also inside strings, escapes and numbers;
+// the lexer state and the open container stack are kept between calls.
+// The tape is complete after Finish(). Tape positions are offsets from the
+// first byte fed, so the readers need the whole text in one piece.
+template <typename OffsetT>
+struct StreamParserT
+{
+public:
+	// the tape goes to capacity words of work, more fails with "tape capacity exceeded"
+	StreamParserT(OffsetT* work, size_t capacity);
+	// the tape grows in arena from its start as the input arrives
+	StreamParserT(TapeArenaT<OffsetT>& arena);
+	
+	// returns false once ErrorMessage is set
+	bool Feed(const char* chunk, size_t len);
+	// call after the last chunk
+	bool Finish();
+	
+	Type GetValueType() const;
+	ObjectReaderT<OffsetT> GetObject(const char* json) const;
+	ArrayReaderT<OffsetT> GetArray(const char* json) const;
+	const OffsetT* GetTape() const { return builder.work; }
+	
+	const char* ErrorMessage;
+private:
+	enum LexState {
+		Lex_None,
+		Lex_String,
+		Lex_Escape,
+		Lex_Unicode,
+		Lex_Utf8,
+		Lex_Number,
+		Lex_Literal,
+	};
+	enum NumberState {
+		Num_Minus,
+		Num_Zero,
+		Num_Int,
+		Num_Dot,
+		Num_Frac,
+		Num_Exp,
+		Num_ExpSign,
+		Num_ExpDigits,
+	};
+	
+	// moves numberState, false when c does not continue the number
+	bool advanceNumber(char c);
+	bool token(TokenType tt, size_t start, size_t length, bool hasEscapes);
+	bool growTape();
+	
+	TapeBuilderT<OffsetT> builder;
+	TapeArenaT<OffsetT>* arena;
+	size_t offset;			// bytes fed so far
+	LexState state;
+	size_t tokenStart;
+	bool hasEscapes;
+	size_t hexRemaining;
+	size_t utf8Remaining;	// continuation bytes still expected
+	unsigned char utf8Low;	// range of the next continuation byte
+	unsigned char utf8High;
+	NumberState numberState;
+	const char* literal;
+	size_t literalMatched;
+	TokenType literalToken;
+};
+
+typedef StreamParserT<uint16_t> StreamParser;
+typedef StreamParserT<uint32_t> StreamParser32;
+
+} // namespace json16
+
@@ -0,0 +1,286 @@
+#include "json16.h"
+#include "json16_writer.h"
+
+#include <string.h>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSON16_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace json16 {
+
+static inline
+unsigned hexValue(char c)
+{
+	if (c <= '9') {
+		return c - '0';
+	}
+	return (c | 0x20) - 'a' + 10;
+}
+
+static inline
+unsigned readHex4(const char* p)
+{
+	return (hexValue(p[0]) << 12) | (hexValue(p[1]) << 8) | (hexValue(p[2]) << 4) | hexValue(p[3]);
+}
+
+static inline
+char* writeUTF8(char* dst, uint32_t cp)
+{
+	if (cp < 0x80) {
+		*dst++ = (char)cp;
+	}else if (cp < 0x800) {
+		*dst++ = (char)(0xC0 | (cp >> 6));
+		*dst++ = (char)(0x80 | (cp & 0x3F));
+	}else if (cp < 0x10000) {
+		*dst++ = (char)(0xE0 | (cp >> 12));
+		*dst++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+		*dst++ = (char)(0x80 | (cp & 0x3F));
+	}else {
+		*dst++ = (char)(0xF0 | (cp >> 18));
+		*dst++ = (char)(0x80 | ((cp >> 12) & 0x3F));
+		*dst++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+		*dst++ = (char)(0x80 | (cp & 0x3F));
+	}
+	return dst;
+}
+
+// copies up to the next backslash, returns its position or end
+static inline
+const char* copyRun(const char* src, const char* end, char*& dst)
+{
+#ifdef JSON16_SSE2
+	// dst never runs ahead of src, so 16 byte stores stay inside s.length
+	const __m128i backslash = _mm_set1_epi8('\\');
+	while (end - src >= 16) {
+		__m128i v = _mm_loadu_si128((const __m128i*)src);
+		_mm_storeu_si128((__m128i*)dst, v);
+		unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash));
+		if (mask) {
+			unsigned n = 0;
+			while (!(mask & 1)) {
+				mask >>= 1;
+				++n;
+			}
+			dst += n;
+			return src + n;
+		}
+		src += 16;
+		dst += 16;
+	}
+#endif
+	const char* bs = (const char*) memchr(src, '\\', end - src);
+	size_t n = (bs ? bs : end) - src;
+	memcpy(dst, src, n);
+	dst += n;
+	return src + n;
+}
+
+size_t Unescape(const StringRef& s, char* dst)
+{
+	if (!s.hasEscapes) {
+		memcpy(dst, s.ptr, s.length);
+		return s.length;
+	}
+	const char* p = s.ptr;
+	const char* end = p + s.length;
+	char* d = dst;
+	for (;;) {
+		p = copyRun(p, end, d);
+		if (p == end) {
+			break;
+		}
+		// the parser has validated every escape sequence
+		char c = p[1];
+		p += 2;
+		switch (c) {
+		case 'b': *d++ = '\b'; break;
+		case 'f': *d++ = '\f'; break;
+		case 'n': *d++ = '\n'; break;
+		case 'r': *d++ = '\r'; break;
+		case 't': *d++ = '\t'; break;
+		case 'u':
+			if (end - p < 4) {
+				// only reachable for text that was not validated
+				p = end;
+				break;
+			}
+			{
+				uint32_t cp = readHex4(p);
+				p += 4;
+				if (cp >= 0xD800 && cp < 0xDC00) {
+					if (end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+						uint32_t low = readHex4(p + 2);
+						if (low >= 0xDC00 && low < 0xE000) {
+							cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+							p += 6;
+						}else {
+							cp = 0xFFFD;
+						}
+					}else {
+						cp = 0xFFFD;
+					}
+				}else if (cp >= 0xDC00 && cp < 0xE000) {
+					// lone low surrogate
+					cp = 0xFFFD;
+				}
+				d = writeUTF8(d, cp);
+			}
+			break;
+		default:
+			// " \ /
+			*d++ = c;
+			break;
+		}
+	}
+	return d - dst;
+}
+
+static inline
+bool writeCodePoint(OutputSink& sink, uint32_t cp)
+{
+	static const char hexDigits[] = "0123456789abcdef";
+	char buff[6];
+	size_t n;
+	if (cp < 0x20) {
+		buff[0] = '\\';
+		n = 2;
+		switch (cp) {
+		case '\b': buff[1] = 'b'; break;
+		case '\f': buff[1] = 'f'; break;
+		case '\n': buff[1] = 'n'; break;
+		case '\r': buff[1] = 'r'; break;
+		case '\t': buff[1] = 't'; break;
+		default:
+			buff[1] = 'u';
+			buff[2] = '0';
+			buff[3] = '0';
+			buff[4] = hexDigits[cp >> 4];
+			buff[5] = hexDigits[cp & 0xF];
+			n = 6;
+			break;
+		}
+	}else if (cp == '"' || cp == '\\') {
+		buff[0] = '\\';
+		buff[1] = (char)cp;
+		n = 2;
+	}else {
+		n = writeUTF8(buff, cp) - buff;
+	}
+	return sink.Write(buff, n);
+}
+
+bool WriteNormalizedString(OutputSink& sink, const StringRef& s)
+{
+	const char* p = s.ptr;
+	const char* end = p + s.length;
+	sink.Put('"');
+	for (;;) {
+		// characters between escapes are valid as they are
+		const char* bs = (const char*) memchr(p, '\\', end - p);
+		const char* runEnd = bs ? bs : end;
+		sink.Write(p, runEnd - p);
+		if (!bs) {
+			break;
+		}
+		// the parser has validated every escape sequence
+		char c = bs[1];
+		p = bs + 2;
+		uint32_t cp;
+		switch (c) {
+		case 'b': cp = '\b'; break;
+		case 'f': cp = '\f'; break;
+		case 'n': cp = '\n'; break;
+		case 'r': cp = '\r'; break;
+		case 't': cp = '\t'; break;
+		case 'u':
+			if (end - p < 4) {
+				// only reachable for text that was not validated
+				p = end;
+				continue;
+			}
+			cp = readHex4(p);
+			p += 4;
+			if (cp >= 0xD800 && cp < 0xDC00) {
+				uint32_t low;
+				if (end - p >= 6 && p[0] == '\\' && p[1] == 'u'
+					&& (low = readHex4(p + 2)) >= 0xDC00 && low < 0xE000
+				) {
+					cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+					p += 6;
+				}else {
+					cp = 0xFFFD;
+				}
+			}else if (cp >= 0xDC00 && cp < 0xE000) {
+				// lone low surrogate
+				cp = 0xFFFD;
+			}
+			break;
+		default:
+			// " \ /
+			cp = (unsigned char)c;
+			break;
+		}
+		writeCodePoint(sink, cp);
+	}
+	return sink.Put('"');
+}
+
+static inline
+bool isPlain(unsigned char c)
+{
+	return c >= 0x20 && c != '"' && c != '\\';
+}
+
+// length of the run that can be copied without escaping
+static inline
+size_t plainRunLength(const char* p, const char* end)
+{
+	const char* start = p;
+#ifdef JSON16_SSE2
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i lastControl = _mm_set1_epi8(0x1F);
+	while (end - p >= 16) {
+		__m128i v = _mm_loadu_si128((const __m128i*)p);
+		__m128i special = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+			_mm_cmpeq_epi8(_mm_min_epu8(v, lastControl), v)	// unsigned v <= 0x1F
+		);
+		unsigned mask = _mm_movemask_epi8(special);
+		if (mask) {
+			while (!(mask & 1)) {
+				mask >>= 1;
+				++p;
+			}
+			return p - start;
+		}
+		p += 16;
+	}
+#endif
+	while (p != end && isPlain(*p)) {
+		++p;
+	}
+	return p - start;
+}
+
+bool WriteString(OutputSink& sink, const char* s, size_t len)
+{
+	const char* p = s;
+	const char* end = s + len;
+	sink.Put('"');
+	for (;;) {
+		size_t n = plainRunLength(p, end);
+		sink.Write(p, n);
+		p += n;
+		if (p == end) {
+			break;
+		}
+		writeCodePoint(sink, (unsigned char)*p++);
+	}
+	return sink.Put('"');
+}
+
+} // namespace json16
+
@@ -0,0 +1,299 @@
+#pragma once
+
+
+/*
+
+value format (W = bit width of OffsetT, 16 or 32)
+
+revision 2 : scalars and names carry their type and token length
+revision 3 : strings carry an escape flag
+
+string
+number
+true
+false
+null
+	isContainer : 1 (false)
+	srcPos : W-1
+	type : 3 (Type)
+	hasEscapes : 1
+	length : W-4 (all ones when the token is longer)
+	
+object
+	isContainer : 1 (true)
+	isObject : 1 (true)
+	count : W-2
+	size : W
+	name[] (same layout as string)
+	value[]
+	
+array
+	isContainer : 1 (true)
+	isObject : 1 (false)
+	count : W-2
+	size : W
+	value[]
+
+side index (optional, separate memory, all words OffsetT)
+
+	tableCount
+	containerOffset[tableCount] : tape offsets in ascending order
+	tableOffset[tableCount] : index offsets of the tables
+	tables
+
+object name table
+	bucketCount : power of two
+	bucket[bucketCount] : tape offset of the name, 0 when empty
+
+array element table
+	count : elements of the array
+	element[count] : tape offset of the element
+
+*/
+
+// Tape layout and low level accessors shared by the json16 translation units.
+
+#include "json16.h"
+#include "json16_entry.h"
+#include "json16_scanner.h"
+#include "assert.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace json16 {
+
+using detail::ValueHeader;
+using detail::ScalarInfo;
+using detail::ContainerHeader;
+using detail::TapeLimits;
+
+template <typename OffsetT>
+static inline
+OffsetT getCount(OffsetT num)
+{
+	// only the first word of the header is there
+	ContainerHeader<OffsetT> v = ContainerHeader<OffsetT>();
+	memcpy(&v, &num, sizeof(num));
+	assert(v.isContainer);
+	return v.count;
+}
+
+template <typename OffsetT>
+static inline
+Type getValueType(const OffsetT* entry)
+{
+	return detail::valueType(entry);
+}
+
+template <typename OffsetT>
+static inline
+size_t getTokenLength(const OffsetT* entry, const char* src)
+{
+	assert(!((const ValueHeader<OffsetT>*) entry)->isContainer);
+	return detail::tokenLength(entry, src);
+}
+
+template <typename OffsetT>
+static inline
+const char* getString(const OffsetT* entry, const char* src)
+{
+	ValueHeader<OffsetT> v = *(const ValueHeader<OffsetT>*) entry;
+	assert(!v.isContainer);
+	assert(getValueType(entry) == Type_string);
+	return src + v.position;
+}
+
+template <typename OffsetT>
+static inline
+StringRef getStringRef(const OffsetT* entry, const char* src)
+{
+	assert(getValueType(entry) == Type_string);
+	return detail::stringValue(entry, src);
+}
+
+template <typename OffsetT>
+static inline
+const char* getNumberText(const OffsetT* entry, const char* src, size_t& length)
+{
+	assert(getValueType(entry) == Type_number);
+	return detail::numberText(entry, src, length);
+}
+
+template <typename OffsetT>
+static inline
+size_t entrySize(const OffsetT* entry)
+{
+	return detail::entrySize(entry);
+}
+
+template <typename OffsetT>
+static inline
+bool isContainerEntry(const OffsetT* entry)
+{
+	return ((const ValueHeader<OffsetT>*) entry)->isContainer;
+}
+
+template <typename OffsetT>
+static inline
+bool isObjectEntry(const OffsetT* entry)
+{
+	return isContainerEntry(entry) && ((const ContainerHeader<OffsetT>*) entry)->isObject;
+}
+
+// source position of a scalar or name, containers have none
+template <typename OffsetT>
+static inline
+size_t entryPosition(const OffsetT* entry)
+{
+	return ((const ValueHeader<OffsetT>*) entry)->position;
+}
+
+static inline
+bool isSpaceChar(char c)
+{
+	switch (c) {
+	case ' ': case '\t': case '\n': case '\v': case '\f': case '\r':
+		return true;
+	}
+	return false;
+}
+
+static inline
+size_t skipSpace(const char* json, size_t len, size_t pos)
+{
+	while (pos < len && isSpaceChar(json[pos])) {
+		++pos;
+	}
+	return pos;
+}
+
+static inline
+size_t skipSpaceBack(const char* json, size_t pos)
+{
+	while (pos && isSpaceChar(json[pos - 1])) {
+		--pos;
+	}
+	return pos;
+}
+
+// Containers have no source position on the tape. The opening bracket is
+// found from the first token inside: in front of it there are only spaces,
+// commas, an opening bracket for every container entered on the way and both
+// brackets of those that end before it. False when there is no token inside.
+template <typename OffsetT>
+static inline
+bool findContainerStart(const char* src, const OffsetT* tape, size_t v, size_t& position)
+{
+	size_t end = v + entrySize(&tape[v]);
+	size_t t = v;
+	while (t < end && isContainerEntry(&tape[t])) {
+		t += 2;
+	}
+	if (t == end) {
+		return false;
+	}
+	size_t brackets = 0;
+	for (size_t x=v; x<t; x+=2) {
+		brackets += (x + entrySize(&tape[x]) <= t) ? 2 : 1;
+	}
+	size_t p = entryPosition(&tape[t]);
+	while (brackets) {
+		switch (src[--p]) {
+		case '{': case '}': case '[': case ']':
+			--brackets;
+			break;
+		}
+	}
+	position = p;
+	return true;
+}
+
+// FNV-1a
+static inline
+uint32_t hashName(const char* p, size_t len)
+{
+	uint32_t h = 2166136261U;
+	for (size_t i=0; i<len; ++i) {
+		h = (h ^ (unsigned char)p[i]) * 16777619U;
+	}
+	return h;
+}
+
+// calls func(unescaped name bytes, length), unescaping only when needed
+template <typename FuncT>
+static inline
+bool withUnescapedName(const StringRef& name, FuncT& func)
+{
+	if (!name.hasEscapes) {
+		return func(name.ptr, name.length);
+	}
+	char stackBuff[256];
+	char* buff = (name.length <= sizeof(stackBuff)) ? stackBuff : (char*) malloc(name.length);
+	size_t len = Unescape(name, buff);
+	bool ret = func(buff, len);
+	if (buff != stackBuff) {
+		free(buff);
+	}
+	return ret;
+}
+
+struct NameEquals
+{
+	NameEquals(const char* key, size_t len) : key(key), len(len) {}
+	bool operator () (const char* p, size_t n) const
+	{
+		return n == len && memcmp(p, key, n) == 0;
+	}
+	const char* key;
+	size_t len;
+};
+
+struct NameHash
+{
+	bool operator () (const char* p, size_t n)
+	{
+		hash = hashName(p, n);
+		return true;
+	}
+	uint32_t hash;
+};
+
+static inline
+bool nameEquals(const StringRef& name, const char* key, size_t len)
+{
+	if (!name.hasEscapes) {
+		return name.length == len && memcmp(name.ptr, key, len) == 0;
+	}
+	// unescaping never makes a name longer
+	if (len > name.length) {
+		return false;
+	}
+	NameEquals eq(key, len);
+	return withUnescapedName(name, eq);
+}
+
+// returns the side index table of the container at offset, or 0
+template <typename OffsetT>
+static inline
+const OffsetT* findTable(const OffsetT* index, OffsetT offset)
+{
+	size_t tableCount = index[0];
+	const OffsetT* containerOffsets = index + 1;
+	size_t lo = 0, hi = tableCount;
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+		if (containerOffsets[mid] < offset) {
+			lo = mid + 1;
+		}else {
+			hi = mid;
+		}
+	}
+	if (lo == tableCount || containerOffsets[lo] != offset) {
+		return 0;
+	}
+	return index + containerOffsets[tableCount + lo];
+}
+
+} // namespace json16
+
@@ -0,0 +1,145 @@
+#include "json16_thread.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <stdlib.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace json16 {
+
+Thread::Thread()
+	:
+	handle(),
+	started(false),
+	func(0),
+	arg(0)
+{
+}
+
+Thread::~Thread()
+{
+	Join();
+}
+
+#ifdef _WIN32
+
+unsigned long __stdcall Thread::run(void* self)
+{
+	Thread* t = (Thread*) self;
+	t->func(t->arg);
+	return 0;
+}
+
+bool Thread::Start(Func func, void* arg)
+{
+	if (started) {
+		return false;
+	}
+	this->func = func;
+	this->arg = arg;
+	handle = CreateThread(0, 0, run, this, 0, 0);
+	started = (handle != 0);
+	return started;
+}
+
+void Thread::Join()
+{
+	if (!started) {
+		return;
+	}
+	WaitForSingleObject(handle, INFINITE);
+	CloseHandle(handle);
+	handle = 0;
+	started = false;
+}
+
+Mutex::Mutex()
+{
+	section = malloc(sizeof(CRITICAL_SECTION));
+	InitializeCriticalSection((CRITICAL_SECTION*)section);
+}
+
+Mutex::~Mutex()
+{
+	DeleteCriticalSection((CRITICAL_SECTION*)section);
+	free(section);
+}
+
+void Mutex::Lock()
+{
+	EnterCriticalSection((CRITICAL_SECTION*)section);
+}
+
+void Mutex::Unlock()
+{
+	LeaveCriticalSection((CRITICAL_SECTION*)section);
+}
+
+size_t GetProcessorCount()
+{
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors ? info.dwNumberOfProcessors : 1;
+}
+
+#else
+
+void* Thread::run(void* self)
+{
+	Thread* t = (Thread*) self;
+	t->func(t->arg);
+	return 0;
+}
+
+bool Thread::Start(Func func, void* arg)
+{
+	if (started) {
+		return false;
+	}
+	this->func = func;
+	this->arg = arg;
+	started = (pthread_create(&handle, 0, run, this) == 0);
+	return started;
+}
+
+void Thread::Join()
+{
+	if (!started) {
+		return;
+	}
+	pthread_join(handle, 0);
+	started = false;
+}
+
+Mutex::Mutex()
+{
+	pthread_mutex_init(&mutex, 0);
+}
+
+Mutex::~Mutex()
+{
+	pthread_mutex_destroy(&mutex);
+}
+
+void Mutex::Lock()
+{
+	pthread_mutex_lock(&mutex);
+}
+
+void Mutex::Unlock()
+{
+	pthread_mutex_unlock(&mutex);
+}
+
+size_t GetProcessorCount()
+{
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return (n > 0) ? (size_t)n : 1;
+}
+
+#endif
+
+} // namespace json16
+
@@ -0,0 +1,63 @@
+#pragma once
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+namespace json16 {
+
+// Bare thread on Win32 or pthreads, for the parallel parsers.
+struct Thread
+{
+public:
+	typedef void (*Func)(void* arg);
+	
+	Thread();
+	// joins a thread that is still running
+	~Thread();
+	
+	bool Start(Func func, void* arg);
+	void Join();
+	
+private:
+	Thread(const Thread&);
+	Thread& operator=(const Thread&);
+	
+#ifdef _WIN32
+	static unsigned long __stdcall run(void* self);
+	void* handle;
+#else
+	static void* run(void* self);
+	pthread_t handle;
+#endif
+	bool started;
+	Func func;
+	void* arg;
+};
+
+// Lock around short sections shared between the threads.
+struct Mutex
+{
+public:
+	Mutex();
+	~Mutex();
+	
+	void Lock();
+	void Unlock();
+	
+private:
+	Mutex(const Mutex&);
+	Mutex& operator=(const Mutex&);
+	
+#ifdef _WIN32
+	void* section;		// CRITICAL_SECTION, kept out of the header with windows.h
+#else
+	pthread_mutex_t mutex;
+#endif
+};
+
+// number of logical processors, at least 1
+size_t GetProcessorCount();
+
+} // namespace json16
+
@@ -0,0 +1,357 @@
+#include "json16_writer.h"
+#include "json16_tape.h"
+#include "json16_number.h"
+
+#include <stdlib.h>
+
+namespace json16 {
+
+bool OutputSink::writeSlow(const char* p, size_t len)
+{
+	if (failed) {
+		return false;
+	}
+	while (len > capacity - length) {
+		size_t n = capacity - length;
+		memcpy(buffer + length, p, n);
+		length += n;
+		p += n;
+		len -= n;
+		if (!makeRoom(len) || length == capacity) {
+			failed = true;
+			return false;
+		}
+	}
+	memcpy(buffer + length, p, len);
+	length += len;
+	return true;
+}
+
+GrowableSink::GrowableSink(size_t initialCapacity)
+	:
+	OutputSink((char*)malloc(initialCapacity ? initialCapacity : 1), initialCapacity ? initialCapacity : 1)
+{
+	if (!buffer) {
+		capacity = 0;
+		failed = true;
+	}
+}
+
+GrowableSink::~GrowableSink()
+{
+	free(buffer);
+}
+
+bool GrowableSink::makeRoom(size_t needed)
+{
+	size_t newCapacity = capacity * 2;
+	while (newCapacity - length < needed) {
+		newCapacity *= 2;
+	}
+	char* p = (char*) realloc(buffer, newCapacity);
+	if (!p) {
+		return false;
+	}
+	buffer = p;
+	capacity = newCapacity;
+	return true;
+}
+
+static inline
+bool writeIndent(OutputSink& sink, size_t depth)
+{
+	static const char tabs[] = "\n\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+	if (depth > sizeof(tabs) - 2) {
+		depth = sizeof(tabs) - 2;
+	}
+	return sink.Write(tabs, depth + 1);
+}
+
+template <typename OffsetT>
+static inline
+bool writeToken(OutputSink& sink, const OffsetT* entry, const char* src, unsigned flags)
+{
+	ValueHeader<OffsetT> v = *(const ValueHeader<OffsetT>*) entry;
+	ScalarInfo<OffsetT> si = *(const ScalarInfo<OffsetT>*) &entry[1];
+	if (si.hasEscapes && (flags & Serialize_NormalizeStrings)) {
+		return WriteNormalizedString(sink, getStringRef(entry, src));
+	}
+	return sink.Write(src + v.position, getTokenLength(entry, src));
+}
+
+template <typename OffsetT>
+bool Serialize(const ObjectReaderT<OffsetT>& container, OutputSink& sink, unsigned flags)
+{
+	const OffsetT* tape = container.GetTape();
+	const char* src = container.GetSource();
+	bool pretty = (flags & Serialize_Pretty) != 0;
+	
+	// containers are entered in tape order, ends[] tells where they close
+	size_t ends[Writer::MaxDepth];
+	uint32_t objectBits = 0;
+	size_t depth = 0;
+	bool first = true;
+	size_t i = container.GetTapeOffset();
+	for (;;) {
+		const OffsetT* entry = &tape[i];
+		ValueHeader<OffsetT> vh = *(const ValueHeader<OffsetT>*) entry;
+		if (vh.isContainer) {
+			ContainerHeader<OffsetT> ch = *(const ContainerHeader<OffsetT>*) entry;
+			if (depth == sizeof(ends) / sizeof(ends[0])) {
+				return false;
+			}
+			ends[depth++] = i + ch.size;
+			objectBits = (objectBits << 1) | ch.isObject;
+			sink.Put(ch.isObject ? '{' : '[');
+			first = true;
+			i += 2;
+		}else {
+			writeToken(sink, entry, src, flags);
+			first = false;
+			i += 2;
+		}
+		// close finished containers
+		while (i == ends[depth-1]) {
+			--depth;
+			if (pretty && !first) {
+				writeIndent(sink, depth);
+			}
+			sink.Put((objectBits & 1) ? '}' : ']');
+			objectBits >>= 1;
+			first = false;
+			if (depth == 0) {
+				return !sink.Failed();
+			}
+		}
+		if (!first) {
+			sink.Put(',');
+		}
+		if (pretty) {
+			writeIndent(sink, depth);
+		}
+		if (objectBits & 1) {
+			writeToken(sink, &tape[i], src, flags);
+			if (pretty) {
+				sink.Write(": ", 2);
+			}else {
+				sink.Put(':');
+			}
+			i += 2;
+		}
+		if (sink.Failed()) {
+			return false;
+		}
+	}
+}
+
+Writer::Writer(OutputSink& sink)
+	:
+	ErrorMessage(0),
+	sink(sink),
+	objectBits(0),
+	depth(0),
+	first(true),
+	afterKey(false),
+	complete(false)
+{
+}
+
+bool Writer::checkSink()
+{
+	if (sink.Failed()) {
+		ErrorMessage = "output sink is full";
+		return false;
+	}
+	return true;
+}
+
+// separator in front of a value, false when no value may come here
+bool Writer::beginValue()
+{
+	if (ErrorMessage) {
+		return false;
+	}
+	if (depth == 0) {
+		ErrorMessage = complete ? "extra content after root value" : "root value must be an object or an array";
+		return false;
+	}
+	if (objectBits & 1) {
+		if (!afterKey) {
+			ErrorMessage = "value in object without a key";
+			return false;
+		}
+		afterKey = false;
+	}else if (!first) {
+		sink.Put(',');
+	}
+	first = false;
+	return true;
+}
+
+bool Writer::beginContainer(bool isObject)
+{
+	if (ErrorMessage) {
+		return false;
+	}
+	if (depth == MaxDepth) {
+		ErrorMessage = "nesting too deep";
+		return false;
+	}
+	if (depth == 0 && !complete) {
+		// root
+	}else if (!beginValue()) {
+		return false;
+	}
+	sink.Put(isObject ? '{' : '[');
+	objectBits = (objectBits << 1) | (isObject ? 1 : 0);
+	++depth;
+	first = true;
+	return checkSink();
+}
+
+bool Writer::endContainer(bool isObject)
+{
+	if (ErrorMessage) {
+		return false;
+	}
+	if (depth == 0) {
+		ErrorMessage = "no open container";
+		return false;
+	}
+	if ((objectBits & 1) != (uint32_t)isObject) {
+		ErrorMessage = isObject ? "EndObject closes an array" : "EndArray closes an object";
+		return false;
+	}
+	if (afterKey) {
+		ErrorMessage = "key without value";
+		return false;
+	}
+	sink.Put(isObject ? '}' : ']');
+	objectBits >>= 1;
+	--depth;
+	first = false;
+	complete = (depth == 0);
+	return checkSink();
+}
+
+bool Writer::BeginObject()
+{
+	return beginContainer(true);
+}
+
+bool Writer::EndObject()
+{
+	return endContainer(true);
+}
+
+bool Writer::BeginArray()
+{
+	return beginContainer(false);
+}
+
+bool Writer::EndArray()
+{
+	return endContainer(false);
+}
+
+bool Writer::Key(const char* name, size_t len)
+{
+	if (ErrorMessage) {
+		return false;
+	}
+	if (!(depth && (objectBits & 1))) {
+		ErrorMessage = "key outside of an object";
+		return false;
+	}
+	if (afterKey) {
+		ErrorMessage = "key without value";
+		return false;
+	}
+	if (!first) {
+		sink.Put(',');
+	}
+	WriteString(sink, name, len);
+	sink.Put(':');
+	afterKey = true;
+	return checkSink();
+}
+
+bool Writer::String(const char* s, size_t len)
+{
+	if (!beginValue()) {
+		return false;
+	}
+	WriteString(sink, s, len);
+	return checkSink();
+}
+
+bool Writer::Number(double value)
+{
+	if (value - value != 0) {
+		ErrorMessage = "number is not finite";
+		return false;
+	}
+	if (!beginValue()) {
+		return false;
+	}
+	char buff[FormatDoubleMaxLength];
+	sink.Write(buff, FormatDouble(value, buff));
+	return checkSink();
+}
+
+bool Writer::Int64(int64_t value)
+{
+	if (!beginValue()) {
+		return false;
+	}
+	char buff[FormatIntegerMaxLength];
+	sink.Write(buff, FormatInt64(value, buff));
+	return checkSink();
+}
+
+bool Writer::UInt64(uint64_t value)
+{
+	if (!beginValue()) {
+		return false;
+	}
+	char buff[FormatIntegerMaxLength];
+	sink.Write(buff, FormatUInt64(value, buff));
+	return checkSink();
+}
+
+bool Writer::Bool(bool value)
+{
+	if (!beginValue()) {
+		return false;
+	}
+	if (value) {
+		sink.Write("true", 4);
+	}else {
+		sink.Write("false", 5);
+	}
+	return checkSink();
+}
+
+bool Writer::Null()
+{
+	if (!beginValue()) {
+		return false;
+	}
+	sink.Write("null", 4);
+	return checkSink();
+}
+
+bool Writer::RawValue(const char* json, size_t len)
+{
+	if (!beginValue()) {
+		return false;
+	}
+	sink.Write(json, len);
+	return checkSink();
+}
+
+template bool Serialize(const ObjectReaderT<uint16_t>& container, OutputSink& sink, unsigned flags);
+template bool Serialize(const ObjectReaderT<uint32_t>& container, OutputSink& sink, unsigned flags);
+
+} // namespace json16
+
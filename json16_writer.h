@@ -0,0 +1,154 @@
+#pragma once
+
+#include "json16.h"
+
+#include <string.h>
+
+namespace json16 {
+
+// Destination of the serializer.
+// The base class writes into a fixed caller buffer and drops output that
+// does not fit. Derived sinks override makeRoom to drain or grow the buffer.
+struct OutputSink
+{
+public:
+	OutputSink(char* buffer, size_t capacity)
+		:
+		buffer(buffer),
+		capacity(capacity),
+		length(0),
+		failed(false)
+	{
+	}
+	virtual ~OutputSink() {}
+	
+	bool Write(const char* p, size_t len)
+	{
+		if (len == 0) {
+			return true;
+		}
+		if (len <= capacity - length) {
+			memcpy(buffer + length, p, len);
+			length += len;
+			return true;
+		}
+		return writeSlow(p, len);
+	}
+	bool Put(char c)
+	{
+		if (length < capacity) {
+			buffer[length++] = c;
+			return true;
+		}
+		return writeSlow(&c, 1);
+	}
+	
+	// output that has not been drained yet
+	const char* GetData() const { return buffer; }
+	size_t GetLength() const { return length; }
+	// set once output had to be dropped
+	bool Failed() const { return failed; }
+	
+protected:
+	// Called when the buffer is full and needed more bytes are waiting.
+	// Either pass buffer[0, length) on and reset length, or point buffer
+	// at a bigger block. Returning false drops the rest of the output.
+	virtual bool makeRoom(size_t /*needed*/) { return false; }
+	
+	char* buffer;
+	size_t capacity;
+	size_t length;
+	bool failed;
+	
+private:
+	bool writeSlow(const char* p, size_t len);
+};
+
+// Sink that keeps the whole output in one heap block, doubling it as needed.
+struct GrowableSink : OutputSink
+{
+public:
+	GrowableSink(size_t initialCapacity = 4096);
+	~GrowableSink();
+	
+protected:
+	bool makeRoom(size_t needed);
+	
+private:
+	GrowableSink(const GrowableSink&);
+	GrowableSink& operator=(const GrowableSink&);
+};
+
+enum SerializeFlags {
+	Serialize_Minified = 0,
+	Serialize_Pretty = 1,				// one member per line, tab indentation
+	Serialize_NormalizeStrings = 2,		// minimal escapes instead of the original string bytes
+};
+
+// Writes the container the reader was created for, independent of its read position.
+// Number and string tokens are copied from the source text as they are,
+// unless Serialize_NormalizeStrings asks to rewrite strings that contain escapes.
+// Like Writer, it goes at most Writer::MaxDepth containers deep and returns
+// false for a tape that nests deeper, which a parser with a bigger MaxDepth
+// in its policy can produce.
+template <typename OffsetT>
+bool Serialize(const ObjectReaderT<OffsetT>& container, OutputSink& sink, unsigned flags = Serialize_Minified);
+
+// Writes s (UTF-8) as a quoted string, escaping only " \\ and control characters.
+bool WriteString(OutputSink& sink, const char* s, size_t len);
+
+// Writes the content of s as a quoted string with the minimal escapes:
+// \" \\ \b \f \n \r \t and \u00XX for the other control characters.
+// Escape sequences in s are decoded first.
+bool WriteNormalizedString(OutputSink& sink, const StringRef& s);
+
+// Writes JSON text call by call, the counterpart of ObjectReader.
+// Nesting is checked with the same bit stack the parser uses; a call that
+// does not fit the current position sets ErrorMessage and writes nothing.
+// Like the parser, the root has to be an object or an array.
+struct Writer
+{
+public:
+	enum {
+		MaxDepth = 32,	// bits in objectBits
+	};
+	
+	Writer(OutputSink& sink);
+	
+	bool BeginObject();
+	bool EndObject();
+	bool BeginArray();
+	bool EndArray();
+	// member name, only inside an object and before every value there
+	bool Key(const char* name, size_t len);
+	
+	bool String(const char* s, size_t len);
+	// NaN and infinities have no JSON form and are rejected
+	bool Number(double value);
+	bool Int64(int64_t value);
+	bool UInt64(uint64_t value);
+	bool Bool(bool value);
+	bool Null();
+	// a value that is already JSON text, copied as it is
+	bool RawValue(const char* json, size_t len);
+	
+	// the root container has been closed
+	bool IsComplete() const { return complete; }
+	
+	const char* ErrorMessage;
+private:
+	bool beginValue();
+	bool beginContainer(bool isObject);
+	bool endContainer(bool isObject);
+	bool checkSink();
+	
+	OutputSink& sink;
+	uint32_t objectBits;
+	size_t depth;
+	bool first;			// nothing written yet in the current container
+	bool afterKey;		// a name was written, its value is due
+	bool complete;
+};
+
+} // namespace json16
+
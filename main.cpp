@@ -2,9 +2,11 @@
 #include <stdio.h>
 
 #include "json16.h"
-#include "json16_scanner.h"
+#include "json16_context.h"
+#include "json16_range.h"
 
 #include <string.h>
+#include <string>
 #include <vector>
 
 static inline
@@ -16,34 +18,34 @@ size_t getFileSize(FILE* file)
 	return length;
 }
 
-std::string toString(const char* str)
+std::string toString(const json16::StringRef& str)
 {
-	const char* strEnd = str;
-	json16::Scan(strEnd);
-	char buff[256];
-	size_t len = strEnd-str;
-	memcpy(buff, str, len);
-	buff[len] = 0;
-	return buff;
+	std::string ret(str.length, '\0');
+	if (str.length) {
+		ret.resize(json16::Unescape(str, &ret[0]));
+	}
+	return ret;
 }
 
-template <typename ReaderT>
-void printValue(json16::Type type, ReaderT& reader)
+void printObject(const json16::ObjectReader& reader);
+void printArray(const json16::ArrayReader& reader);
+
+void printValue(const json16::ValueRef& value)
 {
-	switch (type) {
+	switch (value.GetValueType()) {
 	case json16::Type_string:
-		printf("string %s\n", toString(reader.ReadString()).c_str());
+		printf("string %s\n", toString(value.GetStringRef()).c_str());
 		break;
 	case json16::Type_number:
-		printf("double %f\n", reader.ReadNumber());
+		printf("double %f\n", value.GetNumber());
 		break;
 	case json16::Type_object:
 		printf("object\n");
-		printObject(reader.ReadObject());
+		printObject(value.GetObject());
 		break;
 	case json16::Type_array:
 		printf("array\n");
-		printArray(reader.ReadArray());
+		printArray(value.GetArray());
 		break;
 	case json16::Type_true:
 		printf("true\n");
@@ -55,33 +57,26 @@ void printValue(json16::Type type, ReaderT& reader)
 		printf("null\n");
 		break;
 	}
-	reader.MoveNext();
 }
 
-void printObject(json16::ObjectReader& reader)
+void printObject(const json16::ObjectReader& reader)
 {
-	uint16_t cnt = reader.GetCount();
-	for (uint16_t i=0; i<cnt; ++i) {
-		const char* name = reader.ReadName();
-		printf("name = %s\n", toString(name).c_str());
-		json16::Type type = reader.GetValueType();
-		printValue(type, reader);
+	for (json16::MemberIterator it=begin(reader); it!=end(reader); ++it) {
+		json16::Member member = *it;
+		printf("name = %s\n", toString(member.name).c_str());
+		printValue(member.value);
 	}
 }
 
-void printArray(json16::ArrayReader& reader)
+void printArray(const json16::ArrayReader& reader)
 {
-	uint16_t cnt = reader.GetCount();
-	for (uint16_t i=0; i<cnt; ++i) {
-		json16::Type type = reader.GetValueType();
-		printValue(type, reader);
+	for (json16::ElementIterator it=begin(reader); it!=end(reader); ++it) {
+		printValue(*it);
 	}
 }
 
 int main(int argc, char* argv[])
 {
-	uint16_t work[512];
-
 	if (argc < 2) {
 		return 0;
 	}
@@ -92,10 +87,14 @@ int main(int argc, char* argv[])
 	fread(&buff[0], 1, sz, f);
 	fclose(f);
 	
-	json16::Parser parser(&buff[0], sz, work);
+	json16::ParserContext context;
+	if (!context.Parse(&buff[0], sz)) {
+		printf("%s\n", context.ErrorMessage);
+		return 1;
+	}
 
-	json16::Type type = parser.GetValueType();
-	json16::ObjectReader reader = parser.GetObject();
+	json16::Type type = context.GetValueType();
+	json16::ObjectReader reader = context.GetObject();
 	printObject(reader);
 	return 0;
 }